@@ -2,15 +2,25 @@
 #define ZXSHADY_BIGINT_HPP
 
 #include <iosfwd>
-
+#include <istream>
+#include <ostream>
+#include <sstream>
+
+#include <algorithm>
+#include <cctype>
+#include <cmath>
+#include <memory>
 #include <vector>
 #include <string>
 #include <type_traits>
 #include <limits>
 #include <stdexcept>
 #include <utility>
+#include <tuple>
+#include <random>
 #include <iterator>
 #include <cstddef>
+#include <climits>
 #include <cstring>
 #include <cassert>
 #include <system_error>
@@ -27,6 +37,63 @@
 #include "iterator.hpp"
 #include "reference.hpp"
 
+#if defined(ZXSHADY_CPP17) && defined(__has_include)
+#if __has_include(<memory_resource>)
+
+#include <memory_resource>
+
+#endif
+#endif
+
+// bits per limb of zxshady::bigint, 32 stores 9 decimal digits per limb and 64 stores 18
+// with 128 bit products, which halves the limb count of every loop.
+// other radices and allocators are picked through basic_bigint directly.
+// define before including, 64 needs a compiler with unsigned __int128.
+#ifndef ZXSHADY_BIGINT_LIMB_BITS
+#define ZXSHADY_BIGINT_LIMB_BITS 32
+#endif
+
+// the thresholds below count limbs of 9 decimal digits, every basic_bigint scales
+// them to its own radix so it switches algorithms at the same number of digits.
+
+// limb count (of the smaller operand) at which bigint::mul switches
+// from the schoolbook loop to karatsuba, define before including to tune it.
+#ifndef ZXSHADY_BIGINT_KARATSUBA_THRESHOLD
+#define ZXSHADY_BIGINT_KARATSUBA_THRESHOLD 40
+#endif
+
+// limb counts at which bigint::mul moves on to toom-3 and toom-4.
+#ifndef ZXSHADY_BIGINT_TOOM3_THRESHOLD
+#define ZXSHADY_BIGINT_TOOM3_THRESHOLD 450
+#endif
+
+#ifndef ZXSHADY_BIGINT_TOOM4_THRESHOLD
+#define ZXSHADY_BIGINT_TOOM4_THRESHOLD 1200
+#endif
+
+// limb count at which bigint::mul switches to the number theoretic transform.
+#ifndef ZXSHADY_BIGINT_NTT_THRESHOLD
+#define ZXSHADY_BIGINT_NTT_THRESHOLD 2000
+#endif
+
+// divisor limb count at which bigint::div switches from long division
+// to burnikel-ziegler recursive division.
+#ifndef ZXSHADY_BIGINT_BURNIKEL_ZIEGLER_THRESHOLD
+#define ZXSHADY_BIGINT_BURNIKEL_ZIEGLER_THRESHOLD 60
+#endif
+
+// divisor and quotient limb count at which bigint::div switches to
+// multiplying by a newton iteration reciprocal.
+#ifndef ZXSHADY_BIGINT_NEWTON_THRESHOLD
+#define ZXSHADY_BIGINT_NEWTON_THRESHOLD 8000
+#endif
+
+// modulus limb count at which montgomery reduction switches from the limb
+// by limb loop to two multiplications with a precomputed inverse.
+#ifndef ZXSHADY_BIGINT_REDC_THRESHOLD
+#define ZXSHADY_BIGINT_REDC_THRESHOLD 160
+#endif
+
 namespace zxshady {
 
 template<typename>
@@ -43,6 +110,25 @@ template<> struct double_width<std::int8_t>  { using type = std::int16_t; };
 template<> struct double_width<std::int16_t> { using type = std::int32_t; };
 template<> struct double_width<std::int32_t> { using type = std::int64_t; };
 
+// 128 bit products for 64 bit limbs where the compiler has them,
+// define ZXSHADY_BIGINT_NO_INT128 before including to stay on 32 bit limbs.
+#if defined(__SIZEOF_INT128__) && !defined(ZXSHADY_BIGINT_NO_INT128)
+#define ZXSHADY_BIGINT_HAS_INT128 1
+
+__extension__ typedef unsigned __int128 uint128_t;
+__extension__ typedef __int128 int128_t;
+
+template<> struct double_width<std::uint64_t> { using type = uint128_t; };
+template<> struct double_width<std::int64_t> { using type = int128_t; };
+
+#endif
+
+#if ZXSHADY_BIGINT_LIMB_BITS == 64 && !defined(ZXSHADY_BIGINT_HAS_INT128)
+#error "ZXSHADY_BIGINT_LIMB_BITS 64 needs unsigned __int128"
+#elif ZXSHADY_BIGINT_LIMB_BITS != 32 && ZXSHADY_BIGINT_LIMB_BITS != 64
+#error "ZXSHADY_BIGINT_LIMB_BITS must be 32 or 64"
+#endif
+
 template<typename T>
 struct half_width { using type = T; };
 
@@ -86,6 +172,12 @@ template<typename T,typename E = std::errc>
 struct result {
     T val;
     E ec{};
+
+    // a default member initializer keeps result from being an aggregate in C++11,
+    // so `return { value, error };` needs a constructor to call
+    result() = default;
+    constexpr result(T value, E error = E{}) noexcept : val(value), ec(error) {}
+
     constexpr bool operator!() const noexcept
     {
         return ec != E{};
@@ -103,20 +195,93 @@ template<class T> struct is_signed_integer   : public std::integral_constant<boo
 template<class T> struct is_unsigned_integer : public std::integral_constant<bool,std::is_integral<T>::value && std::is_unsigned<T>::value > {};
 
 enum noinit_t {};
-class bigint final {
+
+namespace details {
+namespace bigint {
+
+constexpr bool is_pow10(unsigned long long x) noexcept
+{
+    return x == 1 || (x != 0 && x % 10 == 0 && is_pow10(x / 10));
+}
+
+// the threshold macros count limbs of 9 digits, the same number of digits in limbs of `digits` digits
+constexpr std::size_t scale_threshold(std::size_t threshold, std::size_t digits) noexcept
+{
+    return (threshold * 9 + digits - 1) / digits;
+}
+
+// std::max is only constexpr from C++14 on
+constexpr std::size_t constexpr_max(std::size_t a, std::size_t b) noexcept
+{
+    return a < b ? b : a;
+}
+
+}
+}
+
+/// @brief signed integer of any size kept as little endian limbs of kDigitCountOfMax decimal digits
+/// @tparam Limb unsigned type of at least 32 bits storing one limb, double_width<Limb> must be twice as wide
+/// @tparam Base radix of the limbs, a power of 10 where 2 * Base - 1 still fits in Limb
+/// @tparam Allocator allocator of the limbs
+/// @note zxshady::bigint is the default 9 digit (or 18 digit, see ZXSHADY_BIGINT_LIMB_BITS) configuration
+template<typename Limb, Limb Base, typename Allocator = std::allocator<Limb>>
+class basic_bigint final {
+private:
+    using bigint = basic_bigint;
+
+    static_assert(std::is_unsigned<Limb>::value && sizeof(Limb) >= sizeof(std::uint32_t),
+        "zxshady::basic_bigint Limb must be an unsigned type of at least 32 bits");
+    static_assert(sizeof(typename double_width<Limb>::type) == 2 * sizeof(Limb),
+        "zxshady::basic_bigint Limb needs a double_width type twice as wide");
+    static_assert(Base >= 10 && details::bigint::is_pow10(Base),
+        "zxshady::basic_bigint Base must be a power of 10");
+    static_assert(Base - 1 <= (std::numeric_limits<Limb>::max)() - Base,
+        "zxshady::basic_bigint 2 * Base - 1 must fit in Limb");
+
 private: /********PRIVATE CONSTRUCTORS ***********/
     
-    bigint(noinit_t, bool is_negative = false) noexcept
+    basic_bigint(noinit_t, bool is_negative = false) noexcept
         : mIsNegative(is_negative)
     {
     }
+
+    basic_bigint(noinit_t, const Allocator& alloc, bool is_negative = false) noexcept
+        : mNumbers(alloc)
+        , mIsNegative(is_negative)
+    {
+    }
 private:
-    using number_type = std::uint32_t;
+    using number_type = Limb;
+    constexpr static number_type kMaxDigitsInNumber = Base;
     using DoubleWidthType = typename double_width<number_type>::type;
-    constexpr static number_type kMaxDigitsInNumber = static_cast<number_type>(1e9);
     constexpr static auto kDigitCountOfMaxInHex = ::zxshady::math::constexpr_log(kMaxDigitsInNumber, 16);
     constexpr static auto kDigitCountOfMaxInBinary = ::zxshady::math::constexpr_log(kMaxDigitsInNumber, 2);
     constexpr static auto kDigitCountOfMax = ::zxshady::math::constexpr_log(kMaxDigitsInNumber, 10);
+    constexpr static std::size_t kKaratsubaThreshold = details::bigint::scale_threshold(ZXSHADY_BIGINT_KARATSUBA_THRESHOLD, kDigitCountOfMax);
+    constexpr static std::size_t kToom3Threshold = details::bigint::scale_threshold(ZXSHADY_BIGINT_TOOM3_THRESHOLD, kDigitCountOfMax);
+    constexpr static std::size_t kToom4Threshold = details::bigint::scale_threshold(ZXSHADY_BIGINT_TOOM4_THRESHOLD, kDigitCountOfMax);
+    constexpr static std::size_t kNttThreshold = details::bigint::scale_threshold(ZXSHADY_BIGINT_NTT_THRESHOLD, kDigitCountOfMax);
+    constexpr static std::size_t kBurnikelZieglerThreshold = details::bigint::scale_threshold(ZXSHADY_BIGINT_BURNIKEL_ZIEGLER_THRESHOLD, kDigitCountOfMax);
+    // reciprocal_limbs needs at least 16 limbs
+    constexpr static std::size_t kNewtonThreshold = details::bigint::constexpr_max(details::bigint::scale_threshold(ZXSHADY_BIGINT_NEWTON_THRESHOLD, kDigitCountOfMax), 16);
+    constexpr static std::size_t kRedcThreshold = details::bigint::scale_threshold(ZXSHADY_BIGINT_REDC_THRESHOLD, kDigitCountOfMax);
+    // most bits mul_2exp / div_2exp shift by in a single pass over the limbs
+    // (the shifted limb and the carry must fit in DoubleWidthType)
+    constexpr static unsigned kMaxShiftPerPass = sizeof(DoubleWidthType) * CHAR_BIT - kDigitCountOfMaxInBinary - 2;
+    // biggest divisor div_limbs_small can take, remainder * B + limb must fit in DoubleWidthType
+    constexpr static DoubleWidthType kMaxSmallDivisor = (static_cast<DoubleWidthType>(-1) - kMaxDigitsInNumber) / kMaxDigitsInNumber;
+    // biggest product of small primes small_prime_test hands to mod_small, which takes 64 bit divisors
+    constexpr static DoubleWidthType kMaxSmallPrimeProduct = kMaxSmallDivisor < (std::numeric_limits<std::uint64_t>::max)() ? kMaxSmallDivisor : (std::numeric_limits<std::uint64_t>::max)();
+    // longest product the three ntt primes support (2^23 digits of base 1e9), they only take limbs of 9k digits
+    constexpr static std::size_t kNttMaxSize = kDigitCountOfMax % 9 == 0 ? (std::size_t{ 1 } << 23) / (kDigitCountOfMax / 9) : 0;
+    // top limbs that hold at least 18 significant digits
+    constexpr static std::size_t kTopLimbs = 1 + (18 + kDigitCountOfMax - 1) / kDigitCountOfMax;
+    // the absolute value of every Integer fits in a single limb
+    template<typename Integer>
+    constexpr static bool fits_in_limb() noexcept
+    {
+        return static_cast<unsigned long long>((std::numeric_limits<Integer>::max)()) < kMaxDigitsInNumber - 1;
+    }
 public:
 
     constexpr static char default_seperator = '\'';
@@ -137,43 +302,70 @@ public:
 
     using reference = ::zxshady::details::bigint::reference<number_type>;
     using const_reference = ::zxshady::details::bigint::reference<const number_type>;
+    using allocator_type = Allocator;
 
 private:
     //using storage_type = std::vector<number_type>;
 
-    using storage_type = std::basic_string<number_type>;
+    using storage_type = std::basic_string<number_type, std::char_traits<number_type>, Allocator>;
 public:
     // @brief a constructor that initializes the bigint to 0
-    bigint()
+    basic_bigint()
         : mNumbers(1, 0)
         , mIsNegative(false)
     {
     }
 
+    /// @brief initializes the bigint to 0 with its limbs allocated by alloc
+    explicit basic_bigint(const allocator_type& alloc)
+        : mNumbers(1, 0, alloc)
+        , mIsNegative(false)
+    {
+    }
+
+    // copies keep the allocator of other so temporaries of an arena stay in it,
+    // assignments keep the allocator of *this
+    basic_bigint(const bigint& other)
+        : mNumbers(other.mNumbers, other.mNumbers.get_allocator())
+        , mIsNegative(other.mIsNegative)
+    {
+    }
+
+    basic_bigint(bigint&&) noexcept = default;
+
+    basic_bigint(const bigint& other, const allocator_type& alloc)
+        : mNumbers(other.mNumbers, alloc)
+        , mIsNegative(other.mIsNegative)
+    {
+    }
+
+    basic_bigint(bigint&& other, const allocator_type& alloc)
+        : mNumbers(std::move(other.mNumbers), alloc)
+        , mIsNegative(other.mIsNegative)
+    {
+    }
 
-    bigint(const bigint&) = default;
-    bigint(bigint&&) noexcept = default;
     bigint& operator=(const bigint&) & = default;
     bigint& operator=(bigint&&) &noexcept = default;
-    ~bigint() noexcept = default;
+    ~basic_bigint() noexcept = default;
 
     template<typename Integer, typename std::enable_if<
         std::is_integral<Integer>::value, int>::type = 0>
-    bigint(Integer num);
+    basic_bigint(Integer num, const allocator_type& alloc = allocator_type());
 
 
-    bigint(std::nullptr_t) = delete;
+    basic_bigint(std::nullptr_t) = delete;
 
     template<typename InputIter, typename std::enable_if<
         !std::is_integral<InputIter>::value, int>::type = 0>
-    bigint(InputIter begin, InputIter end,bigint::base base,char seperator = default_seperator);
+    basic_bigint(InputIter begin, InputIter end,bigint::base base,char seperator = default_seperator, const allocator_type& alloc = allocator_type());
 
     template<typename InputIter, typename std::enable_if<
         !std::is_integral<InputIter>::value, int>::type = 0>
-    bigint(InputIter begin, InputIter end,char seperator = default_seperator);
+    basic_bigint(InputIter begin, InputIter end,char seperator = default_seperator, const allocator_type& alloc = allocator_type());
 
     template<typename Char,typename std::enable_if<std::is_same<char,Char>::value,int>::type = 0>
-    bigint(const char*/*string*/, Char /*seperator*/)
+    basic_bigint(const char*/*string*/, Char /*seperator*/)
     {
         static_assert(zxshady::always_false<Char>::value,
             "bigint(const char* string,char size) overload is deleted becuase"
@@ -182,36 +374,41 @@ public:
             "\nif you want it as the seperator you have to use the iterator constructor.");
     }
 
-    bigint(const char* str, std::size_t size) : bigint(str, str + size) {}
-    explicit bigint(const std::string& str) : bigint(str.c_str(), str.c_str() + str.size()) {}
-    explicit bigint(const char* str) : bigint(str, str + std::strlen(str)) {}
+    basic_bigint(const char* str, std::size_t size, const allocator_type& alloc = allocator_type()) : basic_bigint(str, str + size, default_seperator, alloc) {}
+    explicit basic_bigint(const std::string& str, const allocator_type& alloc = allocator_type()) : basic_bigint(str.c_str(), str.c_str() + str.size(), default_seperator, alloc) {}
+    explicit basic_bigint(const char* str, const allocator_type& alloc = allocator_type()) : basic_bigint(str, str + std::strlen(str), default_seperator, alloc) {}
 #ifdef __cpp_lib_string_view
 
-    explicit bigint(std::string_view str) : bigint(str.begin(), str.end()) {};
+    explicit basic_bigint(std::string_view str, const allocator_type& alloc = allocator_type()) : basic_bigint(str.begin(), str.end(), default_seperator, alloc) {};
 
 #endif // defined(__cpp_lib_string_view)
 
+    /// @brief the allocator of the limbs
+    ZXSHADY_NODISCARD allocator_type get_allocator() const noexcept
+    {
+        return mNumbers.get_allocator();
+    }
 
     bigint& operator=(const char* s) &
     {
-        return *this = bigint{ s };
+        return *this = bigint{ s, get_allocator() };
     }
 
     bigint& operator=(const std::string& s) &
     {
-        return *this = bigint{ s };
+        return *this = bigint{ s, get_allocator() };
     }
 
     template<typename Integral, typename std::enable_if<
         std::is_integral<Integral>::value, int>::type = 0>
-    bigint& operator=(Integral num) & noexcept(sizeof(Integral) < sizeof(number_type))
+    bigint& operator=(Integral num) & noexcept(fits_in_limb<Integral>())
     {
-        // noexcept if sizeof(UnsignedInteger) < sizeof(number_type)
+        // noexcept if every Integral fits in a single limb
         // since the underlying vector has enough memory atleast 1 number_type it will never throw!
         mIsNegative = ::zxshady::is_negative(num);
         mNumbers.clear();
         auto unsigned_num = math::unsigned_abs(num);
-        if ZXSHADY_CONSTEXPR17(sizeof(num) < sizeof(number_type))
+        if ZXSHADY_CONSTEXPR17(fits_in_limb<Integral>())
         {
             mNumbers.push_back(unsigned_num);
         }
@@ -347,8 +544,22 @@ public:
 
     bigint& operator%=(const bigint& rhs) &
     {
-        const auto& ref = bigint::div(*this, rhs, this->is_negative(), rhs.is_negative());
-        *this -= bigint::mul(ref, rhs, ref.is_negative(), rhs.is_negative());
+        bigint quotient{ get_allocator() };
+        bigint::divmod(*this, rhs, quotient, *this);
+        return *this;
+    }
+
+    template<typename Integer, typename std::enable_if<
+        std::is_integral<Integer>::value, int>::type = 0>
+    bigint& operator%=(Integer rhs) &
+    {
+        const auto divisor = math::unsigned_abs(rhs);
+        if (divisor > kMaxSmallDivisor)
+            return *this %= bigint(rhs, get_allocator());
+
+        const bool was_negative = is_negative();
+        *this = mod_small(divisor);
+        set_sign(was_negative);
         return *this;
     }
 
@@ -360,26 +571,12 @@ public:
             return false;
 
         auto unsigned_b = zxshady::math::unsigned_abs(b);
-
-        if ZXSHADY_CONSTEXPR17(sizeof(b) < sizeof(number_type))
-        {
-            // compare least significant
-            return a.mNumbers.size() == 1 && a.mNumbers[0] == unsigned_b;
-        }
-        else {
-            std::size_t index = 0;
-            const auto size = a.mNumbers.size();
-            while (unsigned_b != 0 && index != size) {
-                if (a.mNumbers[index] != unsigned_b % kMaxDigitsInNumber) {
-                    return false;
-                }
-                else {
-                    unsigned_b /= kMaxDigitsInNumber;
-                    index++;
-                }
-            }
-            return true;
+        for (const auto limb : a.mNumbers) {
+            if (limb != unsigned_b % kMaxDigitsInNumber)
+                return false;
+            unsigned_b /= kMaxDigitsInNumber;
         }
+        return unsigned_b == 0;
     }
 
 
@@ -405,54 +602,53 @@ public:
     template<typename Integer,typename std::enable_if<std::is_integral<Integer>::value,int>::type = 0>
     ZXSHADY_NODISCARD friend bool operator<(const bigint& a, Integer b) noexcept
     {
-        if (a.is_negative() && ::zxshady::is_positive(b))
-            return true;
-
-        auto acount = a.digit_count();
-        auto bcount = zxshady::math::digit_count(b);
-
-        if (acount != bcount)
-            return (acount < bcount) != a.is_negative();
-
-        auto unsigned_b = math::unsigned_abs(b);
-
-        if ZXSHADY_CONSTEXPR17(sizeof(Integer) < sizeof(number_type))
-            return a.mNumbers[0] < unsigned_b;
-        else {
-            decltype(unsigned_b) x{ 0 };
-
-            const auto end = a.mNumbers.crend();
-            for (auto iter = a.mNumbers.crbegin(); iter != end; ++iter)
-                x = static_cast<decltype(unsigned_b)>(*iter + x * kMaxDigitsInNumber);
-            return x < unsigned_b;
-        }
+        return compare_abs(a, math::unsigned_abs(b), a.is_negative(), ::zxshady::is_negative(b)) < 0;
     }
 
     template<typename Integer,typename std::enable_if<std::is_integral<Integer>::value,int>::type = 0>
     ZXSHADY_NODISCARD friend bool operator<(Integer a, const bigint& b) noexcept
     {
-        if (::zxshady::is_negative(a) && b.is_positive())
-            return true;
+        return compare_abs(b, math::unsigned_abs(a), b.is_negative(), ::zxshady::is_negative(a)) > 0;
+    }
 
-        const auto acount = math::digit_count(a);
-        const auto bcount = b.digit_count();
+    // bitwise operators act on the two's complement with infinitely many leading ones for negative
+    // numbers like gmp does. the bigint operands are converted to base 2^32 words and the result back,
+    // a full radix conversion per call (seconds for millions of digits), use binary_bigint for bit heavy work
+    bigint& operator&=(const bigint& rhs) &;
+    bigint& operator|=(const bigint& rhs) &;
+    bigint& operator^=(const bigint& rhs) &;
 
-        if (acount != bcount)
-            return (acount < bcount) != ::zxshady::is_negative(a);
+    // a machine word only changes the low 64 bits, these never convert the whole number
+    template<typename Integer, typename std::enable_if<std::is_integral<Integer>::value, int>::type = 0>
+    bigint& operator&=(Integer rhs) &
+    {
+        and_word(static_cast<std::uint64_t>(rhs), ::zxshady::is_negative(rhs));
+        return *this;
+    }
 
-        auto unsigned_a = math::unsigned_abs(a);
-        if ZXSHADY_CONSTEXPR17(sizeof(Integer) < sizeof(number_type))
-            return unsigned_a < b.mNumbers[0];
-        else {
-            decltype(unsigned_a) x{ 0 };
+    template<typename Integer, typename std::enable_if<std::is_integral<Integer>::value, int>::type = 0>
+    bigint& operator|=(Integer rhs) &
+    {
+        or_word(static_cast<std::uint64_t>(rhs), ::zxshady::is_negative(rhs));
+        return *this;
+    }
 
-            const auto end = b.mNumbers.crend();
-            for (auto iter = b.mNumbers.crbegin(); iter != end; ++iter)
-                x = *iter + x * kMaxDigitsInNumber;
-            return unsigned_a < x;
-        }
+    template<typename Integer, typename std::enable_if<std::is_integral<Integer>::value, int>::type = 0>
+    bigint& operator^=(Integer rhs) &
+    {
+        xor_word(static_cast<std::uint64_t>(rhs), ::zxshady::is_negative(rhs));
+        return *this;
     }
 
+    /// @brief *this * 2^bits
+    bigint& operator<<=(unsigned long long bits) &
+    {
+        return mul_2exp(bits);
+    }
+
+    /// @brief *this / 2^bits rounded towards negative infinity (an arithmetic shift)
+    bigint& operator>>=(unsigned long long bits) &;
+
     bigint& operator++() &
     {
         if (is_negative()) {
@@ -510,6 +706,8 @@ public:
         }
 
         --back;
+        // B^k - 1 loses its top limb
+        fix();
         return *this;
     }
 
@@ -574,8 +772,20 @@ public:
     ZXSHADY_NODISCARD const_reverse_iterator crbegin() const noexcept { return const_reverse_iterator(end()); }
     ZXSHADY_NODISCARD const_reverse_iterator crend()   const noexcept { return const_reverse_iterator(begin()); }
 
-    bool is_prime() const noexcept;
+    /// @brief baillie-psw test: trial division by small primes, a strong base 2 test and a strong lucas test
+    /// @note exact below 2^64 where fixed miller-rabin bases decide, no composite passing it is known above
+    ZXSHADY_NODISCARD bool is_prime() const;
+
+    /// @brief trial division by small primes, a strong base 2 test and `rounds` miller-rabin rounds with bases
+    /// drawn from `random` (a UniformRandomBitGenerator), a composite passes with probability below 4^-rounds
+    /// @note values below 2^64 are decided exactly without touching `random`
+    template<typename UniformRandomBitGenerator>
+    ZXSHADY_NODISCARD bool is_prime(unsigned rounds, UniformRandomBitGenerator& random) const;
     bool is_even() const noexcept { return mNumbers[0] % 2 == 0; }
+
+    /// @brief abs(*this) % divisor without building any bigint
+    /// @note divisors above ~1.8e10 go through the regular division
+    ZXSHADY_NODISCARD std::uint64_t mod_small(std::uint64_t divisor) const;
     bool is_odd() const noexcept { return !is_even(); }
     void flip_sign() & noexcept { if (*this) mIsNegative = !mIsNegative; }
     void set_positive() & noexcept { mIsNegative = false; }
@@ -613,9 +823,48 @@ public:
     bigint& double_() &;
     // calls lvalue overload of double_();
     bigint  double_() && { return this->double_(); } 
+
+    /// @brief *this * 2^exponent
+    bigint& mul_2exp(unsigned long long exponent) &;
+    bigint  mul_2exp(unsigned long long exponent) && { return this->mul_2exp(exponent); }
+
+    /// @brief *this / 2^exponent rounded towards zero
+    bigint& div_2exp(unsigned long long exponent) &;
+    bigint  div_2exp(unsigned long long exponent) && { return this->div_2exp(exponent); }
     bool is_pow_of_10() const noexcept;
     bool is_pow_of_2() const noexcept;
 
+    /// @brief number of bits in abs(*this) without leading zeros, 0 for 0
+    /// @note estimated from the top limbs, only values within about 1e-10 bits of a power of 2 are compared exactly
+    ZXSHADY_NODISCARD std::size_t bit_length() const;
+
+    /// @brief bit `index` of *this in two's complement, negative numbers have infinitely many leading ones
+    /// @note indices below 64 only look at the lowest limbs, higher ones divide the limbs below bit `index`
+    /// by 2^index so the cost grows with `index` and not with the size of *this
+    ZXSHADY_NODISCARD bool test_bit(std::size_t index) const;
+
+    /// @brief sets bit `index` of the two's complement of *this to `value`
+    /// @note adds or subtracts 2^index, which has to be built in decimal first
+    bigint& set_bit(std::size_t index, bool value = true) &;
+
+    /// @brief number of set bits, the maximum of std::size_t for negative numbers (they have infinitely many)
+    /// @note converts the whole number to base 2^32 words, binary_bigint::popcount only counts them
+    ZXSHADY_NODISCARD std::size_t popcount() const;
+
+    /// @brief index of the lowest set bit (the same for x and -x), the maximum of std::size_t for 0
+    ZXSHADY_NODISCARD std::size_t count_trailing_zeros() const;
+
+    /// @brief true if *this is the square of an integer
+    /// @note residues mod 64 * 63 * 65 * 11 rule out about 99% of the non squares before any square root is taken
+    bool is_perfect_square() const;
+
+    /// @brief true if *this == a^k for some integers a and k >= 2 (0, 1 and -1 included)
+    bool is_perfect_power() const;
+
+    /// @brief 10^precision / *this rounded towards zero, computed by newton iteration
+    /// @note pass it to bigint::div_by_reciprocal to divide many numbers by *this
+    bigint reciprocal(std::size_t precision) const;
+
     std::string to_string() const;
 
 
@@ -624,20 +873,48 @@ public:
         return (mNumbers.size() - 1) * kDigitCountOfMax + math::digit_count(mNumbers.back());
     }
 
+    /// @brief bits taken by the limbs, bit_length() is the bit count of the value itself
     std::size_t bit_count() const noexcept
     {
         return mNumbers.size() * sizeof(number_type) * CHAR_BIT;
     }
 
 public: /******* FRIENDS AND STATICS ******/
-    friend std::ostream& operator<<(std::ostream& ostream, const bigint& bignum);
-    friend std::istream& operator>>(std::istream& istream, bigint& bignum);
+    template<typename L, L B, typename A>
+    friend std::ostream& operator<<(std::ostream& ostream, const basic_bigint<L, B, A>& bignum);
+    template<typename L, L B, typename A>
+    friend std::istream& operator>>(std::istream& istream, basic_bigint<L, B, A>& bignum);
 
+    /// @brief precomputed montgomery reduction for one modulus, see zxshady::powmod
+    class montgomery_context;
 
-    static bigint pow10(unsigned long long exponent);
+    /// @brief x % modulus for many x with the same modulus, by multiplying with a precomputed reciprocal
+    class barrett_reducer;
+
+
+    static bigint pow10(unsigned long long exponent, const allocator_type& alloc = allocator_type());
 
     static bigint rand(std::size_t num_digits = 1000);
 
+    /// @brief a / b and a % b from a single division
+    /// @return {quotient, remainder}, the quotient is rounded towards zero and the remainder has the sign of a
+    static std::pair<bigint, bigint> divmod(const bigint& a, const bigint& b);
+
+    /// @brief same as divmod(a, b) but writes into quotient and remainder reusing their storage
+    /// @note quotient and remainder may be a or b
+    static void divmod(const bigint& a, const bigint& b, bigint& quotient, bigint& remainder);
+
+    /// @brief abs(*this) in base 2^32, least significant word first (empty for 0)
+    /// @note splits by powers of 2^1024 recursively instead of peeling one word at a time
+    ZXSHADY_NODISCARD std::vector<std::uint32_t> to_words() const;
+
+    /// @brief the non negative number with the base 2^32 `words`, least significant word first
+    static bigint from_words(const std::vector<std::uint32_t>& words);
+
+    /// @brief a / b using reciprocal == b.reciprocal(precision), which is reused between calls
+    /// @note precision should be at least a.digit_count(), if it is not this is a plain a / b
+    static bigint div_by_reciprocal(const bigint& a, const bigint& b, const bigint& reciprocal, std::size_t precision);
+
     /// @brief compares 
     /// @return -1 if a  <  b
     /// @return  0 if a  == b
@@ -736,7 +1013,7 @@ public: /******* FRIENDS AND STATICS ******/
 
         auto unsigned_that = math::unsigned_abs(that);
 
-        if ZXSHADY_CONSTEXPR17(sizeof(Integer) < sizeof(number_type))
+        if ZXSHADY_CONSTEXPR17(fits_in_limb<Integer>())
             return mNumbers[0] < unsigned_that;
         else {
             decltype(unsigned_that) x{ 0 };
@@ -759,7 +1036,7 @@ public: /******* FRIENDS AND STATICS ******/
 
         auto unsigned_that = math::unsigned_abs(that);
 
-        if ZXSHADY_CONSTEXPR17(sizeof(Integer) < sizeof(number_type))
+        if ZXSHADY_CONSTEXPR17(fits_in_limb<Integer>())
             return mNumbers[0] < unsigned_that;
         else {
             decltype(unsigned_that) x{ 0 };
@@ -771,7 +1048,186 @@ public: /******* FRIENDS AND STATICS ******/
         }
     }
 
-    friend bigint fac(bigint x);
+    // optimized function overloads
+
+    ZXSHADY_NODISCARD friend bool operator==(const bigint& a, const std::string& b) noexcept { return a == bigint(b); }
+    ZXSHADY_NODISCARD friend bool operator==(const bigint& a, const char* b) noexcept { return a == bigint(b); }
+    ZXSHADY_NODISCARD friend bool operator==(const std::string& a, const bigint& b) noexcept { return b == a; }
+    ZXSHADY_NODISCARD friend bool operator==(const char* a, const bigint& b) noexcept { return b == a; }
+
+    ZXSHADY_NODISCARD friend bool operator<(const bigint& a, const std::string& b) noexcept { return a < bigint(b); }
+    ZXSHADY_NODISCARD friend bool operator<(const bigint& a, const char* b) noexcept { return a < bigint(b); }
+
+    ZXSHADY_NODISCARD friend bool operator<(const std::string& a, const bigint& b) noexcept { return bigint(a) < b; }
+    ZXSHADY_NODISCARD friend bool operator<(const char* a, const bigint& b) noexcept { return bigint(a) < b; }
+
+    ZXSHADY_DEFINE_FRIEND_COMPARISONS(const bigint&, const bigint&)
+    ZXSHADY_DEFINE_FRIEND_COMPARISONS(const bigint&, const std::string&)
+    ZXSHADY_DEFINE_FRIEND_COMPARISONS(const bigint&, const char*)
+    ZXSHADY_DEFINE_FRIEND_COMPARISONS(const std::string&, const bigint&)
+    ZXSHADY_DEFINE_FRIEND_COMPARISONS(const char*, const bigint&)
+
+    ZXSHADY_DEFINE_FRIEND_ARITHMETIC(bigint, const bigint&)
+
+    template<typename Integer, typename std::enable_if<std::is_integral<Integer>::value, int>::type = 0>
+    ZXSHADY_NODISCARD friend bigint operator+(bigint a, Integer b)
+    {
+        return a += b;
+    }
+
+    template<typename Integer, typename std::enable_if<std::is_integral<Integer>::value, int>::type = 0>
+    ZXSHADY_NODISCARD friend bigint operator+(Integer a, bigint b)
+    {
+        return b += a;
+    }
+
+    template<typename Integer, typename std::enable_if<std::is_integral<Integer>::value, int>::type = 0>
+    ZXSHADY_NODISCARD friend bigint operator-(bigint a, Integer b)
+    {
+        return a -= b;
+    }
+
+    // relies on implicit conversion of left hand side...
+    //template<typename Integer,typename std::enable_if<std::is_integral<Integer>::value,int>::type = 0>
+    //ZXSHADY_NODISCARD friend bigint operator-(Integer a, const bigint& b)
+    //{
+    //    return bigint{ a } - b;
+    //}
+
+    template<typename Integer, typename std::enable_if<std::is_integral<Integer>::value, int>::type = 0>
+    ZXSHADY_NODISCARD friend bigint operator*(bigint a, Integer b)
+    {
+        return a *= b;
+    }
+
+    template<typename Integer, typename std::enable_if<std::is_integral<Integer>::value, int>::type = 0>
+    ZXSHADY_NODISCARD friend bigint operator*(Integer a, bigint b)
+    {
+        return b *= a;
+    }
+
+    template<typename Integer, typename std::enable_if<std::is_integral<Integer>::value, int>::type = 0>
+    ZXSHADY_NODISCARD friend bigint operator/(bigint a, Integer b)
+    {
+        return a /= b;
+    }
+
+    template<typename Integer, typename std::enable_if<std::is_integral<Integer>::value, int>::type = 0>
+    ZXSHADY_NODISCARD friend bigint operator%(bigint a, Integer b)
+    {
+        return a %= b;
+    }
+
+    ZXSHADY_NODISCARD friend bigint operator&(bigint a, const bigint& b) { return a &= b; }
+    ZXSHADY_NODISCARD friend bigint operator|(bigint a, const bigint& b) { return a |= b; }
+    ZXSHADY_NODISCARD friend bigint operator^(bigint a, const bigint& b) { return a ^= b; }
+    ZXSHADY_NODISCARD friend bigint operator<<(bigint a, unsigned long long bits) { return a <<= bits; }
+    ZXSHADY_NODISCARD friend bigint operator>>(bigint a, unsigned long long bits) { return a >>= bits; }
+
+    template<typename Integer, typename std::enable_if<std::is_integral<Integer>::value, int>::type = 0>
+    ZXSHADY_NODISCARD friend bigint operator&(bigint a, Integer b)
+    {
+        return a &= b;
+    }
+
+    template<typename Integer, typename std::enable_if<std::is_integral<Integer>::value, int>::type = 0>
+    ZXSHADY_NODISCARD friend bigint operator&(Integer a, bigint b)
+    {
+        return b &= a;
+    }
+
+    template<typename Integer, typename std::enable_if<std::is_integral<Integer>::value, int>::type = 0>
+    ZXSHADY_NODISCARD friend bigint operator|(bigint a, Integer b)
+    {
+        return a |= b;
+    }
+
+    template<typename Integer, typename std::enable_if<std::is_integral<Integer>::value, int>::type = 0>
+    ZXSHADY_NODISCARD friend bigint operator|(Integer a, bigint b)
+    {
+        return b |= a;
+    }
+
+    template<typename Integer, typename std::enable_if<std::is_integral<Integer>::value, int>::type = 0>
+    ZXSHADY_NODISCARD friend bigint operator^(bigint a, Integer b)
+    {
+        return a ^= b;
+    }
+
+    template<typename Integer, typename std::enable_if<std::is_integral<Integer>::value, int>::type = 0>
+    ZXSHADY_NODISCARD friend bigint operator^(Integer a, bigint b)
+    {
+        return b ^= a;
+    }
+
+    template<typename Integer, typename std::enable_if<std::is_integral<Integer>::value, int>::type = 0> ZXSHADY_NODISCARD friend bool operator!=(Integer a, const bigint& b) noexcept { return !(a == b); }
+    template<typename Integer, typename std::enable_if<std::is_integral<Integer>::value, int>::type = 0> ZXSHADY_NODISCARD friend bool operator!=(const bigint& a, Integer b) noexcept { return !(a == b); }
+
+    template<typename Integer, typename std::enable_if<std::is_integral<Integer>::value, int>::type = 0>
+    ZXSHADY_NODISCARD friend bool operator>(const bigint& a, Integer b) noexcept
+    {
+        return b < a;
+    }
+
+    template<typename Integer, typename std::enable_if<std::is_integral<Integer>::value, int>::type = 0>
+    ZXSHADY_NODISCARD friend bool operator<=(const bigint& a, Integer b) noexcept
+    {
+        return !(a > b);
+    }
+
+    template<typename Integer, typename std::enable_if<std::is_integral<Integer>::value, int>::type = 0>
+    ZXSHADY_NODISCARD friend bool operator>=(const bigint& a, Integer b) noexcept
+    {
+        return !(a < b);
+    }
+
+    template<typename Integer, typename std::enable_if<std::is_integral<Integer>::value, int>::type = 0>
+    ZXSHADY_NODISCARD friend bool operator>(Integer a, const bigint& b) noexcept
+    {
+        return b < a;
+    }
+
+    template<typename Integer, typename std::enable_if<std::is_integral<Integer>::value, int>::type = 0>
+    ZXSHADY_NODISCARD friend bool operator<=(Integer a, const bigint& b) noexcept
+    {
+        return !(a > b);
+    }
+
+    template<typename Integer, typename std::enable_if<std::is_integral<Integer>::value, int>::type = 0>
+    ZXSHADY_NODISCARD friend bool operator>=(Integer a, const bigint& b) noexcept
+    {
+        return !(a < b);
+    }
+
+    /// @brief makes a copy of *this (NOTE to make it positive use bigint::abs(*this))
+    /// @return a copy of *this
+    ZXSHADY_NODISCARD friend bigint operator+(bigint x)
+    {return x;};
+
+    /// @brief negates sign
+    /// @return negates the sign and returns a copy
+    ZXSHADY_NODISCARD friend bigint operator-(bigint x)
+    {x.flip_sign();return x;};
+
+    /// @brief bitwise not, -x - 1 in two's complement
+    /// @return a copy with every bit flipped
+    ZXSHADY_NODISCARD friend bigint operator~(bigint x)
+    {x.flip_sign();--x;return x;};
+
+    template<typename L, L B, typename A>
+    friend basic_bigint<L, B, A> fac(basic_bigint<L, B, A> x);
+    template<typename L, L B, typename A>
+    friend basic_bigint<L, B, A> pow(basic_bigint<L, B, A> base, unsigned long long exponent);
+    template<typename L, L B, typename A>
+    friend std::pair<basic_bigint<L, B, A>, basic_bigint<L, B, A>> sqrtrem(const basic_bigint<L, B, A>& x);
+    template<typename L, L B, typename A>
+    friend basic_bigint<L, B, A> iroot(const basic_bigint<L, B, A>& x, unsigned long long n);
+    template<typename L, L B, typename A>
+    friend basic_bigint<L, B, A> gcd(basic_bigint<L, B, A> a, basic_bigint<L, B, A> b);
+    template<typename L, L B, typename A>
+    friend std::tuple<basic_bigint<L, B, A>, basic_bigint<L, B, A>, basic_bigint<L, B, A>> xgcd(const basic_bigint<L, B, A>& a, const basic_bigint<L, B, A>& b);
+    template<typename L, L B, typename A>
+    friend basic_bigint<L, B, A> invmod(const basic_bigint<L, B, A>& a, const basic_bigint<L, B, A>& m);
 
 private:
     static int parseDigit(char digit,int base = 10)
@@ -836,6 +1292,30 @@ private:
         return mul(b, a, b_negative, a_negative);
     }
 
+    // sign of a - b where b is given as its absolute value and sign
+    template<typename Unsigned>
+    static int compare_abs(const bigint& a, Unsigned unsigned_b, bool a_negative, bool b_negative) noexcept
+    {
+        if (a_negative != b_negative)
+            return a_negative ? -1 : 1;
+
+        // abs(a) from the top limb down, stopping as soon as it cannot fit in Unsigned
+        // kept in Unsigned itself so 128 bit integers are not cut down to 64 bits
+        constexpr Unsigned kLimit = (std::numeric_limits<Unsigned>::max)();
+        Unsigned x = 0;
+        int ret = 0;
+        for (auto iter = a.mNumbers.crbegin(); iter != a.mNumbers.crend(); ++iter) {
+            if (*iter > kLimit || x > static_cast<Unsigned>(kLimit - *iter) / kMaxDigitsInNumber) {
+                ret = 1;
+                break;
+            }
+            x = static_cast<Unsigned>(x * kMaxDigitsInNumber + *iter);
+        }
+        if (ret == 0)
+            ret = x < unsigned_b ? -1 : x > unsigned_b ? 1 : 0;
+        return a_negative ? -ret : ret;
+    }
+
     static bool eq(const bigint& a, const bigint& b, bool a_negative, bool b_negative) noexcept
     {
         return a_negative == b_negative && a.mNumbers == b.mNumbers;
@@ -846,8 +1326,83 @@ private:
     static void add_compound(bigint& a, const bigint& b, bool a_negative, bool b_negative);
     static void sub_compound(bigint& a, const bigint& b, bool a_negative, bool b_negative);
     static bigint mul(const bigint& a, const bigint& b, bool a_negative, bool b_negative);
+    static bigint sqr(const bigint& a);
+    // left to right sliding window exponentiation, exponent must not be 0
+    static bigint pow_window(const bigint& base, unsigned long long exponent);
     static bigint div(const bigint& a, const bigint& b, bool a_negative, bool b_negative);
 
+    // limb kernels, they work on raw little endian limbs and never look at the sign.
+    // `out` must hold asize + bsize zeroed limbs, `alloc` allocates their scratch limbs.
+
+    static number_type add_limbs(number_type* r, std::size_t rsize, const number_type* a, std::size_t asize) noexcept;
+    static void sub_limbs(number_type* r, std::size_t rsize, const number_type* a, std::size_t asize) noexcept;
+    // a < b, leading zero limbs are allowed
+    static bool lt_limbs(const number_type* a, std::size_t asize, const number_type* b, std::size_t bsize) noexcept;
+    // divides r in place and returns the remainder, divisor must be at most kMaxSmallDivisor
+    static DoubleWidthType div_limbs_small(number_type* r, std::size_t rsize, DoubleWidthType divisor) noexcept;
+    // returns x / B and stores x % B in remainder, x must be below B * 2^(limb bits)
+    static number_type div_base(DoubleWidthType x, number_type& remainder) noexcept;
+    static bigint from_limbs(const number_type* limbs, std::size_t size, const allocator_type& alloc = allocator_type());
+    // limbs [first, last) of x
+    static bigint limb_slice(const bigint& x, std::size_t first, std::size_t last);
+    // high * B^n + low, low must fit in n limbs
+    static bigint concat_limbs(bigint high, const bigint& low, std::size_t n);
+    static void mul_schoolbook(const number_type* a, std::size_t asize, const number_type* b, std::size_t bsize, number_type* out) noexcept;
+    // schoolbook products restricted to the limbs barrett reduction looks at: mul_high_limbs leaves out every
+    // a[i] * b[j] with i + j < skip (the top limbs come out a few units short), mul_low_limbs only fills out[0, keep)
+    static void mul_high_limbs(const number_type* a, std::size_t asize, const number_type* b, std::size_t bsize, number_type* out, std::size_t skip) noexcept;
+    static void mul_low_limbs(const number_type* a, std::size_t asize, const number_type* b, std::size_t bsize, number_type* out, std::size_t keep) noexcept;
+    static void mul_karatsuba(const number_type* a, std::size_t asize, const number_type* b, std::size_t bsize, number_type* out, const allocator_type& alloc);
+    static void mul_toom(const number_type* a, std::size_t asize, const number_type* b, std::size_t bsize, number_type* out, std::size_t apieces, std::size_t bpieces, const allocator_type& alloc);
+    static void mul_sliced(const number_type* a, std::size_t asize, const number_type* b, std::size_t bsize, number_type* out, const allocator_type& alloc);
+    static void mul_ntt(const number_type* a, std::size_t asize, const number_type* b, std::size_t bsize, number_type* out, const allocator_type& alloc);
+
+    // b must not have leading zero limbs and asize >= bsize. `quotient` receives
+    // asize - bsize + 1 limbs, `remainder` (can be null) receives bsize limbs.
+    static void div_limbs(const number_type* a, std::size_t asize, const number_type* b, std::size_t bsize, number_type* quotient, number_type* remainder, const allocator_type& alloc);
+    // schoolbook long division (knuth's algorithm D)
+    static void div_schoolbook(const number_type* a, std::size_t asize, const number_type* b, std::size_t bsize, number_type* quotient, number_type* remainder, const allocator_type& alloc);
+    static void div_burnikel_ziegler(const number_type* a, std::size_t asize, const number_type* b, std::size_t bsize, number_type* quotient, number_type* remainder, const allocator_type& alloc);
+    // the two mutually recursive steps of burnikel-ziegler, b is normalized and has n (or 2 * n) limbs
+    static void div_2n_1n(const bigint& a, const bigint& b, std::size_t n, bigint& quotient, bigint& remainder);
+    static void div_3n_2n(const bigint& a, const bigint& b, std::size_t n, bigint& quotient, bigint& remainder);
+    // division by multiplying with a reciprocal of b
+    static void div_newton(const number_type* a, std::size_t asize, const number_type* b, std::size_t bsize, number_type* quotient, number_type* remainder, const allocator_type& alloc);
+    // B^k / d (d positive, k >= its limb count) off by at most a few units, by newton iteration
+    static bigint reciprocal_limbs(const bigint& d, std::size_t k);
+    // abs(x) / 10^exponent rounded down
+    static bigint div_pow10(const bigint& x, std::size_t exponent);
+    // log10(abs(x)) from the top limbs, good to about 15 significant digits
+    static double approximate_log10(const bigint& x) noexcept;
+    // floor(sqrt(x)) and x - root^2 for x >= 0, newton iteration seeded by the square root of the top limbs
+    static void sqrt_newton(const bigint& x, bigint& root, bigint& remainder);
+    // lehmer's gcd, a >= b >= 0 end up as gcd(a, b) and 0. s0 and s1 (both null or both set) go through the same
+    // steps as a and b, starting them at 1 and 0 tracks the multiple of the original a, at 0 and 1 that of the original b
+    static void gcd_lehmer(bigint& a, bigint& b, bigint* s0, bigint* s1);
+    // (a, b) = (p * a + q * b, r * a + s * b) in place, the cofactors are at most B and both results nonnegative
+    static void apply_cofactors(bigint& a, bigint& b, std::int64_t p, std::int64_t q, std::int64_t r, std::int64_t s);
+    // abs(*this) / B^first mod 2^64, 2^(kDigitCountOfMax * j) divides B^j so only the
+    // first 64 / kDigitCountOfMax limbs (rounded up) from first on reach the low 64 bits
+    ZXSHADY_NODISCARD std::uint64_t low_bits(std::size_t first = 0) const noexcept;
+    // *this op rhs where rhs is the two's complement of a 64 bit word, sign extended with ones when rhs_negative
+    void and_word(std::uint64_t rhs, bool rhs_negative);
+    void or_word(std::uint64_t rhs, bool rhs_negative);
+    void xor_word(std::uint64_t rhs, bool rhs_negative);
+    // 1 if prime, 0 if composite, -1 if neither trial division nor the fixed bases below 2^64 could tell
+    ZXSHADY_NODISCARD int small_prime_test() const;
+    // x / 2^s for the largest such s, which is returned
+    static std::size_t remove_twos(bigint& x);
+    // strong probable prime test of the modulus of context (odd, modulus - 1 == d * 2^s) to base
+    static bool is_strong_probable_prime(const montgomery_context& context, const bigint& base, const bigint& d, std::size_t s);
+    // strong lucas test of the modulus of context with selfridge's parameters
+    static bool is_strong_lucas_probable_prime(const montgomery_context& context);
+
+    // squaring kernels, `out` must hold 2 * size zeroed limbs.
+    static void sqr_schoolbook(const number_type* a, std::size_t size, number_type* out) noexcept;
+    static void sqr_karatsuba(const number_type* a, std::size_t size, number_type* out, const allocator_type& alloc);
+    static void sqr_limbs(const number_type* a, std::size_t size, number_type* out, const allocator_type& alloc);
+    static void mul_limbs(const number_type* a, std::size_t asize, const number_type* b, std::size_t bsize, number_type* out, const allocator_type& alloc);
+
     template<typename Integer,typename std::enable_if<std::is_integral<Integer>::value,int>::type = 0>
     static void add_compound(bigint& a, Integer b, bool a_negative, bool b_negative);
 
@@ -857,11 +1412,6 @@ private:
 private:
     void fix() & noexcept
     {
-        if (mNumbers.size() == 1 && mNumbers[0] == 0 && is_negative()) {
-            mIsNegative = false;
-            return;
-        }
-
         if (mNumbers.size() == 0) {
             mNumbers.push_back(0);
             mIsNegative = false;
@@ -871,6 +1421,9 @@ private:
         while (mNumbers.size() > 1 && mNumbers.back() == 0)
             mNumbers.pop_back();
 
+        if (mNumbers.size() == 1 && mNumbers[0] == 0)
+            mIsNegative = false;
+
         assert(!mNumbers.empty());
     }
 
@@ -879,179 +1432,201 @@ private:
     bool mIsNegative;
 };
 
-using signed_bigint = zxshady::bigint;
+/// @brief modular arithmetic on numbers kept as x * R mod modulus (R = Base^n, n the limb count of the modulus),
+/// products are reduced without any division. build it once and pass it to powmod for every
+/// exponentiation with the same modulus.
+/// @note the modulus must be positive and coprime to 10, powmod(base, exponent, modulus) falls back
+/// to division for the other moduli
+template<typename Limb, Limb Base, typename Allocator>
+class basic_bigint<Limb, Base, Allocator>::montgomery_context {
+public:
+    explicit montgomery_context(const bigint& modulus);
 
+    ZXSHADY_NODISCARD const bigint& modulus() const noexcept { return mModulus; }
 
-inline bool is_negative(const bigint& x) noexcept {
-    return x.is_negative();
-}
+    /// @brief one in montgomery form (R mod modulus)
+    ZXSHADY_NODISCARD const bigint& one() const noexcept { return mOne; }
 
-inline bool is_positive(const bigint& x) noexcept {
-    return x.is_positive();
-}
+    /// @brief x * R mod modulus, x can be any value
+    ZXSHADY_NODISCARD bigint to_montgomery(const bigint& x) const;
 
+    /// @brief x / R mod modulus, x must be in [0, modulus * R)
+    ZXSHADY_NODISCARD bigint from_montgomery(bigint x) const;
 
-// optimized function overloads
+    /// @brief a * b / R mod modulus, a and b must be in [0, modulus)
+    ZXSHADY_NODISCARD bigint multiply(const bigint& a, const bigint& b) const;
 
-ZXSHADY_NODISCARD inline bool operator==(const bigint& a,const std::string& b) noexcept { return a == bigint(b);}
-ZXSHADY_NODISCARD inline bool operator==(const bigint& a, const char* b) noexcept { return a == bigint(b); }
-ZXSHADY_NODISCARD inline bool operator==(const std::string& a, const bigint& b) noexcept { return b == a; }
-ZXSHADY_NODISCARD inline bool operator==(const char* a, const bigint& b) noexcept { return b == a; }
+private:
+    // x = x / R mod modulus in place, x must be in [0, modulus * R)
+    void reduce(bigint& x) const;
+
+    bigint mModulus;
+    bigint mOne;
+    bigint mRSquared;
+    // -modulus^-1 mod R, only built when the modulus has at least kRedcThreshold limbs
+    bigint mInverse;
+    // -modulus^-1 mod B
+    number_type mLimbInverse;
+};
 
-ZXSHADY_NODISCARD inline bool operator<(const bigint& a,const std::string& b) noexcept { return a < bigint(b);}
-ZXSHADY_NODISCARD inline bool operator<(const bigint& a, const char* b) noexcept { return a < bigint(b); }
+/// @brief reduces numbers modulo a fixed modulus with two multiplications instead of a division,
+/// the reciprocal B^(2n) / modulus (n = limb count of the modulus) is computed once here.
+/// @note numbers longer than 2n limbs are folded n limbs at a time
+template<typename Limb, Limb Base, typename Allocator>
+class basic_bigint<Limb, Base, Allocator>::barrett_reducer {
+public:
+    /// @brief buffers for the intermediate products, keep one around and
+    /// reduce(x, buffers) stops allocating once they have grown to size
+    class scratch {
+        friend class barrett_reducer;
+    public:
+        scratch() = default;
+        explicit scratch(const allocator_type& alloc) : mQuotient(alloc), mProduct(alloc) {}
+    private:
+        storage_type mQuotient;
+        storage_type mProduct;
+    };
 
-ZXSHADY_NODISCARD inline bool operator<(const std::string& a,const bigint& b) noexcept { return bigint(a) < b;}
-ZXSHADY_NODISCARD inline bool operator<(const char* a,const bigint& b) noexcept { return bigint(a) < b; }
+    explicit barrett_reducer(const bigint& modulus);
 
+    ZXSHADY_NODISCARD const bigint& modulus() const noexcept { return mModulus; }
 
-ZXSHADY_DEFINE_COMPARISONS(const bigint&, const bigint&)
-ZXSHADY_DEFINE_COMPARISONS(const bigint&, const std::string&)
-ZXSHADY_DEFINE_COMPARISONS(const bigint&, const char*)
-ZXSHADY_DEFINE_COMPARISONS(const std::string&,const bigint&)
-ZXSHADY_DEFINE_COMPARISONS(const char*,const bigint&)
+    /// @brief x %= modulus, the result has the sign of x like operator%=
+    void reduce(bigint& x) const;
+    void reduce(bigint& x, scratch& buffers) const;
 
-ZXSHADY_DEFINE_ARITHMETIC(bigint,const bigint&)
+    ZXSHADY_NODISCARD bigint operator()(bigint x) const
+    {
+        reduce(x);
+        return x;
+    }
 
-template<typename Integer,typename std::enable_if<std::is_integral<Integer>::value,int>::type = 0>
-ZXSHADY_NODISCARD bigint operator+(bigint a, Integer b)
-{
-    return a += b;
-}
+private:
+    // reduces the size limbs at x (at most 2n) in place, the limbs past the remainder become 0
+    void reduce_limbs(number_type* x, std::size_t size, scratch& buffers) const;
 
-template<typename Integer,typename std::enable_if<std::is_integral<Integer>::value,int>::type = 0>
-ZXSHADY_NODISCARD bigint operator+(Integer a,bigint b)
-{
-    return b += a;
-}
+    bigint mModulus;
+    bigint mReciprocal;
+};
 
-template<typename Integer,typename std::enable_if<std::is_integral<Integer>::value,int>::type = 0>
-ZXSHADY_NODISCARD bigint operator-(bigint a, Integer b)
-{
-    return a -= b;
-}
+#if ZXSHADY_BIGINT_LIMB_BITS == 64
+using bigint = basic_bigint<std::uint64_t, 1000000000000000000u>;
+#else
+using bigint = basic_bigint<std::uint32_t, 1000000000u>;
+#endif
 
-// relies on implicit conversion of left hand side...
-//template<typename Integer,typename std::enable_if<std::is_integral<Integer>::value,int>::type = 0>
-//ZXSHADY_NODISCARD bigint operator-(Integer a, const bigint& b)
-//{
-//    return bigint{ a } - b;
-//}
+using signed_bigint = zxshady::bigint;
 
-template<typename Integer,typename std::enable_if<std::is_integral<Integer>::value,int>::type = 0>
-ZXSHADY_NODISCARD bigint operator*(bigint a, Integer b)
-{
-    return a *= b;
-}
+#ifdef __cpp_lib_memory_resource
 
-template<typename Integer,typename std::enable_if<std::is_integral<Integer>::value,int>::type = 0>
-ZXSHADY_NODISCARD bigint operator*(Integer a, bigint b)
-{
-    return b *= a;
-}
+namespace pmr {
 
-template<typename Integer,typename std::enable_if<std::is_integral<Integer>::value,int>::type = 0>
-ZXSHADY_NODISCARD bigint operator/(bigint a,Integer b)
-{
-    return a /= b;
-}
+/// @brief zxshady::bigint taking its limbs from a std::pmr::memory_resource,
+/// results of arithmetic use the allocator of the left operand so a whole
+/// computation can run out of one std::pmr::monotonic_buffer_resource
+#if ZXSHADY_BIGINT_LIMB_BITS == 64
+using bigint = basic_bigint<std::uint64_t, 1000000000000000000u, std::pmr::polymorphic_allocator<std::uint64_t>>;
+#else
+using bigint = basic_bigint<std::uint32_t, 1000000000u, std::pmr::polymorphic_allocator<std::uint32_t>>;
+#endif
 
-template<typename Integer,typename std::enable_if<std::is_integral<Integer>::value,int>::type = 0>
-ZXSHADY_NODISCARD bigint operator%(bigint a,Integer b)
-{
-    return a %= b;
 }
 
-template<typename Integer,typename std::enable_if<std::is_integral<Integer>::value,int>::type = 0 > ZXSHADY_NODISCARD bool operator!=(Integer a, const bigint& b) noexcept { return !(a == b); }
-template<typename Integer,typename std::enable_if<std::is_integral<Integer>::value,int>::type = 0 > ZXSHADY_NODISCARD bool operator!=(const bigint& a, Integer b) noexcept { return !(a == b); }
-
+#endif // defined(__cpp_lib_memory_resource)
 
 
-template<typename Integer,typename std::enable_if<std::is_integral<Integer>::value,int>::type = 0 >
-ZXSHADY_NODISCARD bool operator>(const bigint& a,Integer b) noexcept
-{
-    return b < a;
-}
-
-template<typename Integer,typename std::enable_if<std::is_integral<Integer>::value,int>::type = 0 >
-ZXSHADY_NODISCARD bool operator<=(const bigint& a,Integer b) noexcept
-{
-    return !(a > b);
+template<typename Limb, Limb Base, typename Allocator>
+inline bool is_negative(const basic_bigint<Limb, Base, Allocator>& x) noexcept {
+    return x.is_negative();
 }
 
-template<typename Integer,typename std::enable_if<std::is_integral<Integer>::value,int>::type = 0 >
-ZXSHADY_NODISCARD bool operator>=(const bigint& a,Integer b) noexcept
-{
-    return !(a < b);
+template<typename Limb, Limb Base, typename Allocator>
+inline bool is_positive(const basic_bigint<Limb, Base, Allocator>& x) noexcept {
+    return x.is_positive();
 }
 
-template<typename Integer,typename std::enable_if<std::is_integral<Integer>::value,int>::type = 0 >
-ZXSHADY_NODISCARD bool operator>(Integer a,const bigint& b) noexcept
+template<typename Limb, Limb Base, typename Allocator>
+inline void swap(basic_bigint<Limb, Base, Allocator>& a, basic_bigint<Limb, Base, Allocator>& b) noexcept
 {
-    return b < a;
+    a.swap(b);
 }
 
-template<typename Integer,typename std::enable_if<std::is_integral<Integer>::value,int>::type = 0 >
-ZXSHADY_NODISCARD bool operator<=(Integer a,const bigint& b) noexcept
+template<typename Limb, Limb Base, typename Allocator>
+inline basic_bigint<Limb, Base, Allocator> abs(basic_bigint<Limb, Base, Allocator> x)
 {
-    return !(a > b);
+    x.set_positive();
+    return x;
 }
 
-template<typename Integer,typename std::enable_if<std::is_integral<Integer>::value,int>::type = 0 >
-ZXSHADY_NODISCARD bool operator>=(Integer a,const bigint& b) noexcept
+template<typename Limb, Limb Base, typename Allocator>
+basic_bigint<Limb, Base, Allocator> fac(basic_bigint<Limb, Base, Allocator> x);
+template<typename Limb, Limb Base, typename Allocator>
+basic_bigint<Limb, Base, Allocator> binomial(const basic_bigint<Limb, Base, Allocator>& n, basic_bigint<Limb, Base, Allocator> k);
+template<typename Limb, Limb Base, typename Allocator>
+basic_bigint<Limb, Base, Allocator> falling_factorial(const basic_bigint<Limb, Base, Allocator>& x, unsigned long long k);
+template<typename Limb, Limb Base, typename Allocator>
+basic_bigint<Limb, Base, Allocator> rising_factorial(const basic_bigint<Limb, Base, Allocator>& x, unsigned long long k);
+template<typename Limb, Limb Base, typename Allocator>
+unsigned long long log2(const basic_bigint<Limb, Base, Allocator>& x);
+template<typename Limb, Limb Base, typename Allocator>
+unsigned long long log10(const basic_bigint<Limb, Base, Allocator>& x);
+template<typename Limb, Limb Base, typename Allocator>
+unsigned long long log(const basic_bigint<Limb, Base, Allocator>& x, unsigned long long base);
+template<typename Limb, Limb Base, typename Allocator>
+basic_bigint<Limb, Base, Allocator> pow(basic_bigint<Limb, Base, Allocator> base, unsigned long long exponent);
+template<typename Limb, Limb Base, typename Allocator>
+basic_bigint<Limb, Base, Allocator> powmod(const basic_bigint<Limb, Base, Allocator>& base, const basic_bigint<Limb, Base, Allocator>& exponent, const basic_bigint<Limb, Base, Allocator>& modulus);
+template<typename Limb, Limb Base, typename Allocator>
+basic_bigint<Limb, Base, Allocator> powmod(const basic_bigint<Limb, Base, Allocator>& base, const basic_bigint<Limb, Base, Allocator>& exponent, const typename basic_bigint<Limb, Base, Allocator>::montgomery_context& context);
+template<typename Limb, Limb Base, typename Allocator>
+basic_bigint<Limb, Base, Allocator> sqrt(basic_bigint<Limb, Base, Allocator> x);
+/// @brief {floor(sqrt(x)), x - floor(sqrt(x))^2}
+template<typename Limb, Limb Base, typename Allocator>
+std::pair<basic_bigint<Limb, Base, Allocator>, basic_bigint<Limb, Base, Allocator>> sqrtrem(const basic_bigint<Limb, Base, Allocator>& x);
+/// @brief n-th root of x rounded towards zero, x can only be negative for odd n
+template<typename Limb, Limb Base, typename Allocator>
+basic_bigint<Limb, Base, Allocator> iroot(const basic_bigint<Limb, Base, Allocator>& x, unsigned long long n);
+template<typename Limb, Limb Base, typename Allocator>
+basic_bigint<Limb, Base, Allocator> gcd(basic_bigint<Limb, Base, Allocator> a, basic_bigint<Limb, Base, Allocator> b);
+/// @brief {gcd(a, b), x, y} with a * x + b * y == gcd(a, b)
+template<typename Limb, Limb Base, typename Allocator>
+std::tuple<basic_bigint<Limb, Base, Allocator>, basic_bigint<Limb, Base, Allocator>, basic_bigint<Limb, Base, Allocator>> xgcd(const basic_bigint<Limb, Base, Allocator>& a, const basic_bigint<Limb, Base, Allocator>& b);
+/// @brief x in [0, m) with a * x % m == 1, throws std::domain_error if gcd(a, m) != 1
+template<typename Limb, Limb Base, typename Allocator>
+basic_bigint<Limb, Base, Allocator> invmod(const basic_bigint<Limb, Base, Allocator>& a, const basic_bigint<Limb, Base, Allocator>& m);
+template<typename Limb, Limb Base, typename Allocator>
+basic_bigint<Limb, Base, Allocator> lcm(const basic_bigint<Limb, Base, Allocator>& a, const basic_bigint<Limb, Base, Allocator>& b);
+
+// gcd and lcm with a machine integer on either side, these also keep std::gcd and std::lcm
+// (found through the std::allocator argument) from taking a bigint
+template<typename Limb, Limb Base, typename Allocator, typename Integer, typename std::enable_if<std::is_integral<Integer>::value, int>::type = 0>
+basic_bigint<Limb, Base, Allocator> gcd(basic_bigint<Limb, Base, Allocator> a, Integer b)
 {
-    return !(a < b);
+    return gcd(std::move(a), basic_bigint<Limb, Base, Allocator>(b));
 }
 
-inline void swap(bigint& a,bigint& b) noexcept
+template<typename Limb, Limb Base, typename Allocator, typename Integer, typename std::enable_if<std::is_integral<Integer>::value, int>::type = 0>
+basic_bigint<Limb, Base, Allocator> gcd(Integer a, basic_bigint<Limb, Base, Allocator> b)
 {
-    a.swap(b);
+    return gcd(basic_bigint<Limb, Base, Allocator>(a), std::move(b));
 }
 
-/// @brief makes a copy of *this (NOTE to make it positive use bigint::abs(*this))
-/// @return a copy of *this
-ZXSHADY_NODISCARD inline bigint operator+(bigint x)
-{return x;};
-
-/// @brief negates sign
-/// @return negates the sign and returns a copy
-ZXSHADY_NODISCARD inline bigint operator-(bigint x)
-{x.flip_sign();return x;};
-
-
-inline bigint abs(bigint x)
+template<typename Limb, Limb Base, typename Allocator, typename Integer, typename std::enable_if<std::is_integral<Integer>::value, int>::type = 0>
+basic_bigint<Limb, Base, Allocator> lcm(const basic_bigint<Limb, Base, Allocator>& a, Integer b)
 {
-    x.set_positive();
-    return x;
+    return lcm(a, basic_bigint<Limb, Base, Allocator>(b));
 }
 
-inline bigint fac(bigint x)
+template<typename Limb, Limb Base, typename Allocator, typename Integer, typename std::enable_if<std::is_integral<Integer>::value, int>::type = 0>
+basic_bigint<Limb, Base, Allocator> lcm(Integer a, const basic_bigint<Limb, Base, Allocator>& b)
 {
-    if (x.is_negative())
-        throw std::invalid_argument("zxshady::fac(bigint x) input cannot be negative.");
-    // assumes no one is going to try factorial of number bigger than long max
-    // if you REALLY really want it then just make
-    const auto as_long_long = x.template to<unsigned long long>();
-    // 3
-    // 3 * (2-1)
-    x.mNumbers.reserve(1 + (as_long_long*5) / bigint::kDigitCountOfMax);
-    bigint y = x;
-    for (std::size_t i = 2; i <= as_long_long; ++i) {
-        --y;
-        x *= y;
-    }
-    return x;
+    return lcm(basic_bigint<Limb, Base, Allocator>(a), b);
 }
 
-
-
-unsigned long long log2(bigint x);
-unsigned long long log10(const bigint& x);
-unsigned long long log(const bigint& x, unsigned long long base);
-bigint pow(bigint base, unsigned long long exponent);
-bigint sqrt(bigint x);
-bigint gcd(bigint a, bigint b);
-bigint lcm(const bigint& a, const bigint& b);
+template<typename Limb, Limb Base, typename Allocator>
+std::ostream& operator<<(std::ostream& ostream, const basic_bigint<Limb, Base, Allocator>& bignum);
+template<typename Limb, Limb Base, typename Allocator>
+std::istream& operator>>(std::istream& istream, basic_bigint<Limb, Base, Allocator>& bignum);
 
 
 
@@ -1146,6 +1721,13 @@ inline namespace literals {
 
 #include "bigint.inl"
 
+// the default configuration is compiled once in bigint.cpp
+#if ZXSHADY_BIGINT_LIMB_BITS == 64
+extern template class basic_bigint<std::uint64_t, 1000000000000000000u>;
+#else
+extern template class basic_bigint<std::uint32_t, 1000000000u>;
+#endif
+
 }
 
 
@@ -1,10 +1,13 @@
+template<typename Limb, Limb Base, typename Allocator>
 template<typename Integer,
     typename std::enable_if<std::is_integral<Integer>::value,int>::type>
-bigint::bigint(Integer num) : mIsNegative(::zxshady::is_negative(num))
+basic_bigint<Limb, Base, Allocator>::basic_bigint(Integer num, const allocator_type& alloc)
+    : mNumbers(alloc)
+    , mIsNegative(::zxshady::is_negative(num))
 {
     auto unsigned_num = math::unsigned_abs<number_type>(num);
 
-    if ZXSHADY_CONSTEXPR17(sizeof(num) < sizeof(number_type))
+    if ZXSHADY_CONSTEXPR17(fits_in_limb<Integer>())
     {
         mNumbers.push_back(unsigned_num);
     }
@@ -16,9 +19,11 @@ bigint::bigint(Integer num) : mIsNegative(::zxshady::is_negative(num))
     }
 }
 
+template<typename Limb, Limb Base, typename Allocator>
 template<typename InputIter, typename std::enable_if<
     !std::is_integral<InputIter>::value, int>::type>
-bigint::bigint(InputIter begin, InputIter end, char seperator)
+basic_bigint<Limb, Base, Allocator>::basic_bigint(InputIter begin, InputIter end, char seperator, const allocator_type& alloc)
+    : mNumbers(alloc)
 {
     static_assert(std::is_same<char, typename remove_cvref<decltype(*begin)>::type>::value, "InputIter derefenced must return a char");
     int base = 10;
@@ -73,8 +78,8 @@ bigint::bigint(InputIter begin, InputIter end, char seperator)
                     if (parsed == UCHAR_MAX)
                         throw zxshady::bigint_format_error("zxshady::bigint_format_error: invalid character at " + std::to_string(std::distance(it, rend)) + " character was " + std::string(1, *it));
 
-                    const auto pow = math::pow(base, i);
-                    num += static_cast<number_type>(parsed * pow);
+                    const auto pow = math::pow(static_cast<number_type>(base), i);
+                    num += static_cast<number_type>(parsed) * pow;
                 }
                 mNumbers.push_back(num);
             }
@@ -85,7 +90,7 @@ bigint::bigint(InputIter begin, InputIter end, char seperator)
             mNumbers.push_back(0);
             // more efficient if casted to smallest datatype and 
             // using unsigned makes sure to not check for negativness;
-            bigint num = static_cast<unsigned char>(1);
+            bigint num{ static_cast<unsigned char>(1), alloc };
             std::size_t index = 0;
             for (; it != rend; ++it) {
                 const char Char = *it;
@@ -106,7 +111,7 @@ bigint::bigint(InputIter begin, InputIter end, char seperator)
             mNumbers.push_back(0);
             // more efficient if casted to smallest datatype and 
             // using unsigned makes sure to not check for negativness;
-            bigint num = static_cast<unsigned char>(1);
+            bigint num{ static_cast<unsigned char>(1), alloc };
             std::size_t index = 0;
             for (; it != rend; ++it) {
                 const char Char = *it;
@@ -126,7 +131,7 @@ bigint::bigint(InputIter begin, InputIter end, char seperator)
             mNumbers.push_back(0);
             // more efficient if casted to smallest datatype and 
             // using unsigned makes sure to not check for negativness;
-            bigint num = static_cast<unsigned char>(1);
+            bigint num{ static_cast<unsigned char>(1), alloc };
             std::size_t index = 0;
             for (; it != rend; ++it) {
                 const char Char = *it;
@@ -148,9 +153,11 @@ bigint::bigint(InputIter begin, InputIter end, char seperator)
 }
 
 
+template<typename Limb, Limb Base, typename Allocator>
 template<typename InputIter, typename std::enable_if<
     !std::is_integral<InputIter>::value, int>::type>
-bigint::bigint(InputIter begin, InputIter end, bigint::base base, char seperator)
+basic_bigint<Limb, Base, Allocator>::basic_bigint(InputIter begin, InputIter end, bigint::base base, char seperator, const allocator_type& alloc)
+    : mNumbers(alloc)
 {
     static_assert(std::is_same<char, typename remove_cvref<decltype(*begin)>::type>::value, "InputIter derefenced must return a char");
     if (*begin == '-') {
@@ -185,8 +192,8 @@ bigint::bigint(InputIter begin, InputIter end, bigint::base base, char seperator
                     if (parsed == UCHAR_MAX)
                         throw zxshady::bigint_format_error("zxshady::bigint_format_error: invalid character at " + std::to_string(std::distance(it, rend)) + " character was " + std::string(1, *it));
 
-                    const auto pow = math::pow(static_cast<int>(base), i);
-                    num += static_cast<number_type>(parsed * pow);
+                    const auto pow = math::pow(static_cast<number_type>(base), i);
+                    num += static_cast<number_type>(parsed) * pow;
                 }
                 mNumbers.push_back(num);
             }
@@ -197,7 +204,7 @@ bigint::bigint(InputIter begin, InputIter end, bigint::base base, char seperator
             mNumbers.push_back(0);
             // more efficient if casted to smallest datatype and 
             // using unsigned makes sure to not check for negativness;
-            bigint num = static_cast<unsigned char>(1);
+            bigint num{ static_cast<unsigned char>(1), alloc };
             std::size_t index = 0;
             for (; it != rend; ++it) {
                 const char Char = *it;
@@ -217,7 +224,7 @@ bigint::bigint(InputIter begin, InputIter end, bigint::base base, char seperator
             mNumbers.push_back(0);
             // more efficient if casted to smallest datatype and 
             // using unsigned makes sure to not check for negativness;
-            bigint num = static_cast<unsigned char>(1);
+            bigint num{ static_cast<unsigned char>(1), alloc };
             std::size_t index = 0;
             for (; it != rend; ++it) {
                 const char Char = *it;
@@ -239,8 +246,9 @@ bigint::bigint(InputIter begin, InputIter end, bigint::base base, char seperator
         zero();
 }
 
+template<typename Limb, Limb Base, typename Allocator>
 template<typename Integer,typename std::enable_if<std::is_integral<Integer>::value,int>::type>
-void bigint::add_compound(bigint& a, Integer b_, bool a_negative, bool b_negative)
+void basic_bigint<Limb, Base, Allocator>::add_compound(bigint& a, Integer b_, bool a_negative, bool b_negative)
 {
     // auto required here.
     auto b = math::unsigned_abs<number_type>(b_);
@@ -252,7 +260,7 @@ void bigint::add_compound(bigint& a, Integer b_, bool a_negative, bool b_negativ
 
     if (a_negative && !b_negative) {
         // -a + b = b - a 
-        bigint x = b;
+        bigint x{ b, a.get_allocator() };
         sub_compound(x, a, false, false);
         a = std::move(x);
         return;
@@ -288,12 +296,11 @@ void bigint::add_compound(bigint& a, Integer b_, bool a_negative, bool b_negativ
         carry = sum / kMaxDigitsInNumber;
     }
 
-    if (carry > 0) {
-        a.mNumbers.push_back(carry);
-    }
-    
-    while (b != 0) {
-        a.mNumbers.push_back(b % kMaxDigitsInNumber);
+    // a ran out before b, the carry goes into the rest of b
+    while (b != 0 || carry != 0) {
+        const number_type sum = carry + static_cast<number_type>(b % kMaxDigitsInNumber);
+        a.mNumbers.push_back(sum % kMaxDigitsInNumber);
+        carry = sum / kMaxDigitsInNumber;
         b /= kMaxDigitsInNumber;
     }
 
@@ -301,8 +308,9 @@ void bigint::add_compound(bigint& a, Integer b_, bool a_negative, bool b_negativ
 }
 
 
+template<typename Limb, Limb Base, typename Allocator>
 template<typename Integer, typename std::enable_if<std::is_integral<Integer>::value,int>::type >
-void bigint::sub_compound(bigint& a, Integer b_, bool a_negative, bool b_negative)
+void basic_bigint<Limb, Base, Allocator>::sub_compound(bigint& a, Integer b_, bool a_negative, bool b_negative)
 {
     auto b = math::unsigned_abs(b_);
     if (!a_negative && b_negative) {
@@ -319,7 +327,7 @@ void bigint::sub_compound(bigint& a, Integer b_, bool a_negative, bool b_negativ
 
     if (a_negative && b_negative) {
         // -a - -b == (b - a)
-        bigint x = b;
+        bigint x{ b, a.get_allocator() };
         sub_compound(x, a,false,false);
         a = std::move(x);
         return;
@@ -330,7 +338,7 @@ void bigint::sub_compound(bigint& a, Integer b_, bool a_negative, bool b_negativ
     // a < b
     // 2 - 3 == -(3 -2)
     if (a.signless_lt(b)) {
-        bigint x = b;
+        bigint x{ b, a.get_allocator() };
         sub_compound(x,a,false,false);
         a = std::move(x);
         a.flip_sign();
@@ -351,7 +359,7 @@ void bigint::sub_compound(bigint& a, Integer b_, bool a_negative, bool b_negativ
     // 123
     //   9
     // 114
-    for (std::size_t i = 0; i < size && b != 0; i++) {
+    for (std::size_t i = 0; i < size && (b != 0 || carry != 0); i++) {
         std::int64_t diff = carry;
 
         diff += static_cast<std::int64_t>(a.mNumbers[i]);
@@ -373,13 +381,14 @@ void bigint::sub_compound(bigint& a, Integer b_, bool a_negative, bool b_negativ
     a.fix();
 }
 
+template<typename Limb, Limb Base, typename Allocator>
 template<typename Integer,typename std::enable_if<std::is_integral<Integer>::value,int>::type>
-bigint bigint::mul(const bigint& a, Integer b_, bool a_negative, bool b_negative)
+basic_bigint<Limb, Base, Allocator> basic_bigint<Limb, Base, Allocator>::mul(const bigint& a, Integer b_, bool a_negative, bool b_negative)
 {
     auto b = math::unsigned_abs<number_type>(b_);
     if (!a || !b) // using operator! to test for == 0 since it is hardcoded it will be faster!
-        return bigint{};
-    bigint ret{ noinit_t{} };
+        return bigint{ a.get_allocator() };
+    bigint ret{ noinit_t{}, a.get_allocator() };
     const std::size_t asize = a.mNumbers.size();
     const std::size_t bsize = b != 0 ? math::log(b,kMaxDigitsInNumber) + 1
                                      : 1;
@@ -387,15 +396,14 @@ bigint bigint::mul(const bigint& a, Integer b_, bool a_negative, bool b_negative
     ret.mNumbers.resize(asize + bsize + 1);
 
     for (std::size_t i = 0; i < asize; i++) {
-        std::uint64_t carry = 0;
+        DoubleWidthType carry = 0;
         b = math::unsigned_abs<number_type>(b_);
         for (std::size_t j = 0; b != 0; j++,b/=kMaxDigitsInNumber) {
-            const std::uint64_t product = static_cast<std::uint64_t>(a.mNumbers[i]) * static_cast<std::uint64_t>(b % kMaxDigitsInNumber) +
-                carry + static_cast<std::uint64_t>(ret.mNumbers[i + j]);
-            ret.mNumbers[i + j] = static_cast<number_type>(product % kMaxDigitsInNumber);
-            carry = product / kMaxDigitsInNumber;
+            const DoubleWidthType product = static_cast<DoubleWidthType>(a.mNumbers[i]) * static_cast<DoubleWidthType>(b % kMaxDigitsInNumber) +
+                carry + static_cast<DoubleWidthType>(ret.mNumbers[i + j]);
+            carry = div_base(product, ret.mNumbers[i + j]);
         }
-        assert(carry < static_cast<std::uint64_t>(kMaxDigitsInNumber));
+        assert(carry < static_cast<DoubleWidthType>(kMaxDigitsInNumber));
         ret.mNumbers[i + bsize] += static_cast<number_type>(carry);
     }
 
@@ -407,49 +415,3438 @@ bigint bigint::mul(const bigint& a, Integer b_, bool a_negative, bool b_negative
 }
 
 
+template<typename Limb, Limb Base, typename Allocator>
 template<typename Integer,typename std::enable_if<std::is_integral<Integer>::value,int>::type>
-bigint bigint::div(const bigint& a, Integer b_, bool a_negative, bool b_negative)
+basic_bigint<Limb, Base, Allocator> basic_bigint<Limb, Base, Allocator>::div(const bigint& a, Integer b_, bool a_negative, bool b_negative)
 {
 
     if (b_ == 0)
         throw std::invalid_argument("zxshady::bigint::operator/ Division by zero.");
 
-    using DivisorType = typename std::conditional<
-        (sizeof(unsigned long long) >= sizeof(number_type) + sizeof(Integer)),
-        unsigned long long,
-        bigint
-        >::type;
+    const auto b = math::unsigned_abs(b_);
+    // too big for one 64 by 32 bit division per limb
+    if (b > kMaxSmallDivisor)
+        return div(a, bigint(b_, a.get_allocator()), a_negative, b_negative);
 
-    if (a.signless_lt(b_))
-        return bigint{};
+    bigint ret{ a };
+    div_limbs_small(&ret.mNumbers[0], ret.mNumbers.size(), static_cast<DoubleWidthType>(b));
 
-    DivisorType b = math::unsigned_abs(b_);
-    // if the abs(a) is less than abs(b), the quotient is 0
+    ret.mIsNegative = a_negative != b_negative;
+    ret.fix();
+    return ret;
+}
+
+template<typename Limb, Limb Base, typename Allocator>
+template<typename UniformRandomBitGenerator>
+bool basic_bigint<Limb, Base, Allocator>::is_prime(unsigned rounds, UniformRandomBitGenerator& random) const
+{
+    const int small = small_prime_test();
+    if (small >= 0)
+        return small == 1;
 
+    const montgomery_context context(*this);
+    bigint d = *this - static_cast<unsigned char>(1);
+    const std::size_t s = remove_twos(d);
+    if (!is_strong_probable_prime(context, bigint{ 2 }, d, s))
+        return false;
 
-    bigint current{};  // current number in process of division
-    bigint ret{ noinit_t{} };
-    ret.mNumbers.resize(a.mNumbers.size());
-    auto index = ret.mNumbers.size() - 1;
-    const auto it_end = a.mNumbers.crend();
-    for (auto iter = a.mNumbers.crbegin(); iter != it_end; ++iter) {
-        current *= kMaxDigitsInNumber;
-        current += *iter;
-        number_type start = 0;
-        number_type end = kMaxDigitsInNumber;
-        while (start <= end) {
-            number_type mid = (start + end) / 2;
-            if (mid * b <= current)
-                start = mid + 1;
-            else
-                end = mid - 1;
-        }
-        ret.mNumbers[index] = end;
-        --index;
-        current -= end * b;
+    // bases in [2, n - 2], one limb more than n makes the bias of the reduction negligible
+    std::uniform_int_distribution<number_type> limb(0, kMaxDigitsInNumber - 1);
+    const bigint span = *this - static_cast<unsigned char>(3);
+    bigint base{ noinit_t{}, get_allocator() };
+    for (; rounds != 0; --rounds) {
+        base.mNumbers.clear();
+        for (std::size_t i = 0; i <= mNumbers.size(); ++i)
+            base.mNumbers.push_back(limb(random));
+        base.fix();
+        base %= span;
+        base += static_cast<unsigned char>(2);
+        if (!is_strong_probable_prime(context, base, d, s))
+            return false;
+    }
+    return true;
+}
+
+namespace details {
+namespace bigint {
+
+template<typename T,std::size_t N>
+constexpr std::size_t size(const volatile T(&)[N]) noexcept
+{
+    return N;
+}
+
+// base^exponent mod modulus for moduli below 2^32
+inline std::uint64_t pow_mod_word(std::uint64_t base, std::uint64_t exponent, std::uint64_t modulus)
+{
+    std::uint64_t ret = 1 % modulus;
+    base %= modulus;
+    for (; exponent != 0; exponent /= 2) {
+        if (exponent % 2 == 1)
+            ret = ret * base % modulus;
+        base = base * base % modulus;
+    }
+    return ret;
+}
+
+template<typename Integer>
+void int_into_stream(Integer x,std::ostream& ostream)
+{
+    char buffer[1 + zxshady::math::constexpr_log((std::numeric_limits<Integer>::max)())];
+    int i = 0;
+    do {
+        buffer[i] = (x % 10) + '0';
+        i++;
+        x /= 10;
+    } while (x != 0);
+    for (; i > 0; --i) {
+        ostream.put(buffer[i-1]);
+    }
+}
+
+template<typename Integer>
+void int_into_stream_hex(Integer x,std::ostream& ostream)
+{
+    static constexpr const char table[] = {
+        '0','1','2','3','4','5','6','7','8','9','a','b','c','d','e','f'
+    };
+    
+    static_assert(sizeof(table) == 16, "table size different");
+    do {
+        ostream.put(table[x % 16]);
+        x /= 16;
+    } while (x);
+}
+
+template<typename Integer>
+void int_into_stream_bin(Integer x,std::ostream& ostream)
+{
+    do {
+        ostream.put((x % 2) + '0');
+        x /= 2;
+    } while (x);
+}
+
+}
+}
+
+template<typename Limb, Limb Base, typename Allocator>
+basic_bigint<Limb, Base, Allocator> sqrt(basic_bigint<Limb, Base, Allocator> x)
+{
+    if (x.is_negative())
+        throw std::domain_error("zxshady::sqrt(const bigint& x) x must not be negative");
+
+    return sqrtrem(x).first;
+}
+
+template<typename Limb, Limb Base, typename Allocator>
+std::pair<basic_bigint<Limb, Base, Allocator>, basic_bigint<Limb, Base, Allocator>> sqrtrem(const basic_bigint<Limb, Base, Allocator>& x)
+{
+    using bigint = basic_bigint<Limb, Base, Allocator>;
+    if (x.is_negative())
+        throw std::domain_error("zxshady::sqrtrem(const bigint& x) x must not be negative");
+
+    std::pair<bigint, bigint> ret{ bigint{ x.get_allocator() }, bigint{ x.get_allocator() } };
+    bigint::sqrt_newton(x, ret.first, ret.second);
+    return ret;
+}
+
+template<typename Limb, Limb Base, typename Allocator>
+void basic_bigint<Limb, Base, Allocator>::sqrt_newton(const bigint& x, bigint& root, bigint& remainder)
+{
+    const std::size_t n = x.mNumbers.size();
+    if (n <= 2) {
+        const DoubleWidthType value = n == 2 ? static_cast<DoubleWidthType>(x.mNumbers[1]) * kMaxDigitsInNumber + x.mNumbers[0] : x.mNumbers[0];
+        auto s = static_cast<DoubleWidthType>(std::sqrt(static_cast<double>(value)));
+        // the double is only good to 53 bits, one newton step gets 18 digit limbs within a unit
+        if (s != 0)
+            s = (s + value / s) / 2;
+        while (s * s > value)
+            --s;
+        while ((s + 1) * (s + 1) <= value)
+            ++s;
+        // both are below 2^64 as value is below B^2
+        root = static_cast<std::uint64_t>(s);
+        remainder = static_cast<std::uint64_t>(value - s * s);
+        return;
+    }
+
+    // r = floor(sqrt(x / B^2h)) gives r * B^h <= sqrt(x) < (r + 1) * B^h, with h <= (n - 1) / 4
+    // one newton step from there lands on floor(sqrt(x)) or a unit or two above it
+    const std::size_t h = (std::max)((n - 1) / 4, std::size_t{ 1 });
+    bigint top_root{ x.get_allocator() };
+    bigint top_remainder{ x.get_allocator() };
+    sqrt_newton(limb_slice(x, 2 * h, n), top_root, top_remainder);
+    root = concat_limbs(std::move(top_root), bigint{ x.get_allocator() }, h);
+
+    // newton steps never go below floor(sqrt(x)) and shrink while above it,
+    // one unit above is fixed with (root - 1)^2 = root^2 - 2 * root + 1 instead of another division
+    bigint quotient{ x.get_allocator() };
+    bigint rest{ x.get_allocator() };
+    for (;;) {
+        bigint::divmod(x, root, quotient, rest);
+        root += quotient;
+        root.half();
+        remainder = x - sqr(root);
+        if (!remainder.is_negative())
+            return;
+
+        remainder += root;
+        --root;
+        remainder += root;
+        if (!remainder.is_negative())
+            return;
+    }
+}
+
+template<typename Limb, Limb Base, typename Allocator>
+double basic_bigint<Limb, Base, Allocator>::approximate_log10(const bigint& x) noexcept
+{
+    const std::size_t size = x.mNumbers.size();
+    const std::size_t top = size < kTopLimbs ? size : kTopLimbs;
+    double mantissa = 0;
+    for (std::size_t i = size; i-- > size - top;)
+        mantissa = mantissa * kMaxDigitsInNumber + x.mNumbers[i];
+    return std::log10(mantissa) + static_cast<double>((size - top) * kDigitCountOfMax);
+}
+
+template<typename Limb, Limb Base, typename Allocator>
+basic_bigint<Limb, Base, Allocator> iroot(const basic_bigint<Limb, Base, Allocator>& x, unsigned long long n)
+{
+    using bigint = basic_bigint<Limb, Base, Allocator>;
+    if (n == 0)
+        throw std::invalid_argument("zxshady::iroot(const bigint& x, unsigned long long n) n cannot be 0");
+
+    if (x.is_negative()) {
+        if (n % 2 == 0)
+            throw std::domain_error("zxshady::iroot(const bigint& x, unsigned long long n) x must not be negative for even n");
+        bigint ret = iroot(abs(x), n);
+        ret.flip_sign();
+        return ret;
+    }
+
+    if (n == 1 || !x)
+        return x;
+    if (n == 2)
+        return sqrt(x);
+
+    // x < 10^digits <= 2^n
+    if (static_cast<double>(x.digit_count()) * 3.33 < static_cast<double>(n))
+        return bigint{ 1, x.get_allocator() };
+
+    // seed with 10^(log10(x) / n) good to a few digits, the first newton step
+    // lands on or above the root from either side and the rest come down to it
+    const double exponent = bigint::approximate_log10(x) / static_cast<double>(n);
+    bigint root{ x.get_allocator() };
+    if (exponent < 15)
+        root = static_cast<unsigned long long>(std::pow(10.0, exponent)) + 1;
+    else {
+        const auto shift = static_cast<unsigned long long>(exponent) - 15;
+        root = static_cast<unsigned long long>(std::pow(10.0, exponent - static_cast<double>(shift))) + 1;
+        root *= bigint::pow10(shift, x.get_allocator());
+    }
+
+    bool first = true;
+    for (;;) {
+        bigint next = root * (n - 1) + x / pow(root, n - 1);
+        next /= n;
+        if (!first && next >= root)
+            return root;
+        root = std::move(next);
+        first = false;
+    }
+}
+
+template<typename Limb, Limb Base, typename Allocator>
+bool basic_bigint<Limb, Base, Allocator>::is_pow_of_10() const noexcept
+{
+    const auto end = mNumbers.cend() - 1;
+    auto iter = mNumbers.cbegin();
+    for(;iter != end;++iter)
+        if (*iter != 0)
+            return false;
+
+    
+    for (number_type power = 1; power < kMaxDigitsInNumber; power *= 10)
+        if (mNumbers.back() == power)
+            return true;
+    return false;
+
+}
+template<typename Limb, Limb Base, typename Allocator>
+bool basic_bigint<Limb, Base, Allocator>::is_pow_of_2() const noexcept
+{
+    if (!*this) // == 0
+        return true;
+
+    if (is_negative())
+        return false;
+
+    const std::size_t bits = bit_length();
+    if (bits <= 64) {
+        const auto value = to<std::uint64_t>();
+        return (value & (value - 1)) == 0;
+    }
+
+    // the lowest digits (nine at most) and one residue rule out anything but 2^(bits - 1) in a single pass
+    constexpr std::uint64_t kLowDigits = kMaxDigitsInNumber < 1000000000 ? kMaxDigitsInNumber : 1000000000;
+    if (mNumbers[0] % kLowDigits != details::bigint::pow_mod_word(2, bits - 1, kLowDigits) || mod_small(4294967291) != details::bigint::pow_mod_word(2, bits - 1, 4294967291))
+        return false;
+    return bigint(1).mul_2exp(bits - 1) == *this;
+}
+
+template<typename Limb, Limb Base, typename Allocator>
+std::size_t basic_bigint<Limb, Base, Allocator>::bit_length() const
+{
+    const std::size_t n = mNumbers.size();
+    if (n <= 2) {
+        DoubleWidthType value = n == 2 ? static_cast<DoubleWidthType>(mNumbers[1]) * kMaxDigitsInNumber + mNumbers[0] : mNumbers[0];
+        std::size_t ret = 0;
+        for (; value != 0; value >>= 1)
+            ++ret;
+        return ret;
+    }
+
+    // abs(*this) is within one part in 1e18 of top * B^(n - t) where top is made of the t top limbs, which is
+    // log2(top) + d (n - t) log2(10) in bits for d digit limbs. the rounding in there stays far below the margin,
+    // so only an estimate that close to an integer k leaves a doubt about *this >= 2^k
+    const std::size_t t = n < kTopLimbs ? n : kTopLimbs;
+    double top = 0;
+    for (std::size_t i = n; i-- > n - t;)
+        top = top * kMaxDigitsInNumber + mNumbers[i];
+    const double estimate = std::log2(top) + static_cast<double>((n - t) * kDigitCountOfMax) * 3.321928094887362;
+    const double margin = 1e-10 + estimate * 1e-15;
+    const double whole = std::floor(estimate);
+    if (estimate - whole > margin && estimate - whole < 1 - margin)
+        return static_cast<std::size_t>(whole) + 1;
+
+    const auto k = static_cast<std::size_t>(std::floor(estimate + 0.5));
+    return bigint::lt(*this, bigint(1).mul_2exp(k), false, false) ? k : k + 1;
+}
+template<typename Limb, Limb Base, typename Allocator>
+std::string basic_bigint<Limb, Base, Allocator>::to_string() const
+{
+    std::stringstream s;
+    s << *this;
+    return s.str();
+}
+
+template<typename Limb, Limb Base, typename Allocator>
+void basic_bigint<Limb, Base, Allocator>::add_compound(bigint& a, const bigint& b, bool a_negative, bool b_negative) {
+    
+    if (!a_negative && b_negative) {
+        // a + -b = a - b 
+        sub_compound(a, b, false, false);
+        return;
+    }
+    
+    if (a_negative && !b_negative) {
+        // -a + b = b - a 
+        bigint x = b;
+        sub_compound(x, a, false, false);
+        a = std::move(x);
+        return;
+    }
+    
+    if (a_negative && b_negative) {
+        // -a + -b = -(b + a)
+        add_compound(a, b, false, false);
+        a.set_negative();
+        return;
+    }
+
+    number_type carry = 0;
+    
+    const std::size_t asize = a.mNumbers.size();
+    const std::size_t bsize = b.mNumbers.size();
+    const std::size_t max = (std::max)(asize, bsize);
+    const std::size_t min = (std::min)(asize, bsize);
+    std::size_t i = 0;
+    for (; i < min; ++i) {
+        number_type sum = carry;
+        sum += a.mNumbers[i];
+        sum += b.mNumbers[i];
+
+        a.mNumbers[i] = sum % kMaxDigitsInNumber;
+        carry = sum / kMaxDigitsInNumber;
+    }
+
+    for (; i < max; ++i) {
+        number_type sum = carry;
+        if(i < bsize)
+            sum += b.mNumbers[i];
+
+        if (i < asize) {
+            sum += a.mNumbers[i];
+            a.mNumbers[i] = sum % kMaxDigitsInNumber;
+        }
+        else {
+            a.mNumbers.push_back(sum % kMaxDigitsInNumber);
+        }
+        carry = sum / kMaxDigitsInNumber;
+    }
+
+    if (carry != 0) {
+        a.mNumbers.push_back(carry);
+    }
+
+    a.fix();
+}
+
+template<typename Limb, Limb Base, typename Allocator>
+void basic_bigint<Limb, Base, Allocator>::sub_compound(bigint& a, const bigint& b, bool a_negative, bool b_negative)
+{
+    if (!a_negative && b_negative) {
+        // a - -b == a + b
+        bigint::add_compound(a, b, false, false);
+        return;
+    }
+
+    if (a_negative && !b_negative) {
+        // -a - b == -(a+b)
+        bigint::add_compound(a, b, false, false);
+        a.set_negative();
+        return;
+    }
+
+    if (a_negative && b_negative) {
+        // -a - -b == (b - a)
+        // -2 - -3 == -2 + 3 = 3 - 2;
+        bigint x = b;
+        x.set_positive();
+        bigint::sub_compound(x, a, false, false);
+        a = std::move(x);
+        return;
+    }
+
+    if (a.signless_lt(b)) {
+        bigint x = b;
+        bigint::sub_compound(x,a,false,false);
+        a = std::move(x);
+        a.set_sign(!a_negative);
+        return;
+    }
+
+    //   2132
+    // -  343
+    // 
+    //  132
+    //  343
+    // -211 (+1000)
+    // +899
+    //  1 - 0
+
+    std::int64_t carry = 0;
+    const std::size_t asize = a.mNumbers.size();
+    const std::size_t bsize = b.mNumbers.size();
+    const std::size_t min = (std::min)(asize, bsize);
+    const std::size_t max = (std::max)(asize, bsize);
+
+    std::size_t i = 0;
+    for (; i < min; i++) {
+        std::int64_t diff = carry;
+
+        diff += static_cast<std::int64_t>(a.mNumbers[i]);
+        diff -= static_cast<std::int64_t>(b.mNumbers[i]);
+
+        if (diff < 0) {
+            diff += kMaxDigitsInNumber;
+            carry = -1;
+        }
+        else {
+            carry = 0;
+        }
+        a.mNumbers[i] = static_cast<number_type>(diff % kMaxDigitsInNumber);
     }
 
+    for (; i < max; i++) {
+        std::int64_t diff = carry;
+
+        if(i < asize)
+           diff += static_cast<std::int64_t>(a.mNumbers[i]);
+        if(i < bsize)
+            diff -= static_cast<std::int64_t>(b.mNumbers[i]);
+
+        if (diff < 0) {
+            diff += kMaxDigitsInNumber;
+            carry = -1;
+        }
+        else {
+            carry = 0;
+        }
+
+        a.mNumbers[i] = static_cast<number_type>(diff % kMaxDigitsInNumber);
+    }
+
+    a.fix();
+}
+
+template<typename Limb, Limb Base, typename Allocator>
+basic_bigint<Limb, Base, Allocator> basic_bigint<Limb, Base, Allocator>::mul(const bigint& a, const bigint& b, bool a_negative, bool b_negative) 
+{
+    if (!a || !b) // using operator! to test for == 0 since it is hardcoded it will be faster!
+        return bigint{ a.get_allocator() };
+
+    // x * x or x * -x, the squaring kernels only compute the cross products once
+    if (&a == &b || a.mNumbers == b.mNumbers) {
+        bigint ret = sqr(a);
+        ret.mIsNegative = a_negative != b_negative;
+        return ret;
+    }
+
+    bigint ret{ noinit_t{}, a.get_allocator() };
+    const auto asize = a.mNumbers.size();
+    const auto bsize = b.mNumbers.size();
+
+    ret.mNumbers.resize(asize + bsize + 1);
+    mul_limbs(a.mNumbers.data(), asize, b.mNumbers.data(), bsize, &ret.mNumbers[0], ret.get_allocator());
+
+    // remove leading zeroes
     ret.mIsNegative = a_negative != b_negative;
     ret.fix();
+    
+    return ret;
+}
+
+template<typename Limb, Limb Base, typename Allocator>
+basic_bigint<Limb, Base, Allocator> basic_bigint<Limb, Base, Allocator>::sqr(const bigint& a)
+{
+    if (!a)
+        return bigint{ a.get_allocator() };
+
+    bigint ret{ noinit_t{}, a.get_allocator() };
+    const auto size = a.mNumbers.size();
+    ret.mNumbers.resize(2 * size + 1);
+    sqr_limbs(a.mNumbers.data(), size, &ret.mNumbers[0], ret.get_allocator());
+    ret.fix();
     return ret;
 }
+
+namespace details { namespace bigint {
+
+// dividing by a constant is a multiplication the compiler can make up itself
+template<typename Limb, typename DoubleWidth, Limb Base>
+struct base_divisor {
+    static Limb divide(DoubleWidth x, Limb& remainder) noexcept
+    {
+        remainder = static_cast<Limb>(x % Base);
+        return static_cast<Limb>(x / Base);
+    }
+};
+
+// the remainder of the limbs in r by divisor, the quotient is left in r
+template<typename Limb, typename DoubleWidth>
+DoubleWidth div_limbs_word(Limb* r, std::size_t rsize, DoubleWidth base, DoubleWidth divisor) noexcept
+{
+    DoubleWidth remainder = 0;
+    for (std::size_t i = rsize; i-- > 0;) {
+        const DoubleWidth current = remainder * base + r[i];
+        r[i] = static_cast<Limb>(current / divisor);
+        remainder = current % divisor;
+    }
+    return remainder;
+}
+
+// the remainder of the limbs in r by divisor
+template<typename Limb, typename DoubleWidth>
+DoubleWidth mod_limbs_word(const Limb* r, std::size_t rsize, DoubleWidth base, DoubleWidth divisor) noexcept
+{
+    DoubleWidth remainder = 0;
+    for (std::size_t i = rsize; i-- > 0;)
+        remainder = (remainder * base + r[i]) % divisor;
+    return remainder;
+}
+
+#ifdef ZXSHADY_BIGINT_HAS_INT128
+
+constexpr unsigned leading_zeros(std::uint64_t x) noexcept
+{
+    return x >> 63 != 0 ? 0 : 1 + leading_zeros(x << 1);
+}
+
+// 128 by 64 bit division is a library call, so the limb loops divide by a fixed word with
+// the precomputed reciprocal of moller and granlund instead, the quotient must fit in 64 bits
+class word_divisor {
+public:
+    constexpr explicit word_divisor(std::uint64_t divisor) noexcept
+        : mShift(leading_zeros(divisor))
+        , mNormalized(divisor << leading_zeros(divisor))
+        , mReciprocal(static_cast<std::uint64_t>(~uint128_t{ 0 } / (divisor << leading_zeros(divisor))))
+    {
+    }
+
+    std::uint64_t divide(uint128_t x, std::uint64_t& remainder) const noexcept
+    {
+        x <<= mShift;
+        const auto high = static_cast<std::uint64_t>(x >> 64);
+        const auto low = static_cast<std::uint64_t>(x);
+        const uint128_t estimate = static_cast<uint128_t>(mReciprocal) * high + x;
+        auto quotient = static_cast<std::uint64_t>(estimate >> 64) + 1;
+        auto rest = low - quotient * mNormalized;
+        if (rest > static_cast<std::uint64_t>(estimate)) {
+            --quotient;
+            rest += mNormalized;
+        }
+        if (rest >= mNormalized) {
+            ++quotient;
+            rest -= mNormalized;
+        }
+        remainder = rest >> mShift;
+        return quotient;
+    }
+
+private:
+    unsigned mShift;
+    std::uint64_t mNormalized;
+    std::uint64_t mReciprocal;
+};
+
+template<std::uint64_t Base>
+struct base_divisor<std::uint64_t, uint128_t, Base> {
+    static std::uint64_t divide(uint128_t x, std::uint64_t& remainder) noexcept
+    {
+        static constexpr word_divisor kDivisor{ Base };
+        return kDivisor.divide(x, remainder);
+    }
+};
+
+inline uint128_t div_limbs_word(std::uint64_t* r, std::size_t rsize, uint128_t base, uint128_t divisor) noexcept
+{
+    if (divisor >> 64 != 0)
+        return div_limbs_word<std::uint64_t, uint128_t>(r, rsize, base, divisor);
+
+    const word_divisor word(static_cast<std::uint64_t>(divisor));
+    std::uint64_t remainder = 0;
+    for (std::size_t i = rsize; i-- > 0;)
+        r[i] = word.divide(static_cast<uint128_t>(remainder) * base + r[i], remainder);
+    return remainder;
+}
+
+inline uint128_t mod_limbs_word(const std::uint64_t* r, std::size_t rsize, uint128_t base, uint128_t divisor) noexcept
+{
+    if (divisor >> 64 != 0)
+        return mod_limbs_word<std::uint64_t, uint128_t>(r, rsize, base, divisor);
+
+    const word_divisor word(static_cast<std::uint64_t>(divisor));
+    std::uint64_t remainder = 0;
+    for (std::size_t i = rsize; i-- > 0;)
+        word.divide(static_cast<uint128_t>(remainder) * base + r[i], remainder);
+    return remainder;
+}
+
+#endif
+
+} } // namespace details::bigint
+
+template<typename Limb, Limb Base, typename Allocator>
+typename basic_bigint<Limb, Base, Allocator>::number_type basic_bigint<Limb, Base, Allocator>::div_base(DoubleWidthType x, number_type& remainder) noexcept
+{
+    return details::bigint::base_divisor<number_type, DoubleWidthType, kMaxDigitsInNumber>::divide(x, remainder);
+}
+
+template<typename Limb, Limb Base, typename Allocator>
+typename basic_bigint<Limb, Base, Allocator>::number_type basic_bigint<Limb, Base, Allocator>::add_limbs(number_type* r, std::size_t rsize, const number_type* a, std::size_t asize) noexcept
+{
+    assert(asize <= rsize);
+    DoubleWidthType carry = 0;
+    std::size_t i = 0;
+    for (; i < asize; ++i) {
+        const DoubleWidthType sum = carry + r[i] + a[i];
+        carry = div_base(sum, r[i]);
+    }
+
+    for (; i < rsize && carry; ++i) {
+        const DoubleWidthType sum = carry + r[i];
+        carry = div_base(sum, r[i]);
+    }
+    return static_cast<number_type>(carry);
+}
+
+template<typename Limb, Limb Base, typename Allocator>
+void basic_bigint<Limb, Base, Allocator>::sub_limbs(number_type* r, std::size_t rsize, const number_type* a, std::size_t asize) noexcept
+{
+    // r must be bigger than or equal to a
+    assert(asize <= rsize);
+    bool borrow = false;
+    std::size_t i = 0;
+    for (; i < asize; ++i) {
+        const DoubleWidthType sub = static_cast<DoubleWidthType>(a[i]) + borrow;
+        borrow = r[i] < sub;
+        r[i] = static_cast<number_type>(borrow ? r[i] + kMaxDigitsInNumber - sub : r[i] - sub);
+    }
+
+    for (; i < rsize && borrow; ++i) {
+        borrow = r[i] == 0;
+        r[i] = borrow ? kMaxDigitsInNumber - 1 : r[i] - 1;
+    }
+    assert(!borrow);
+}
+
+template<typename Limb, Limb Base, typename Allocator>
+bool basic_bigint<Limb, Base, Allocator>::lt_limbs(const number_type* a, std::size_t asize, const number_type* b, std::size_t bsize) noexcept
+{
+    while (asize > 0 && a[asize - 1] == 0)
+        --asize;
+    while (bsize > 0 && b[bsize - 1] == 0)
+        --bsize;
+    if (asize != bsize)
+        return asize < bsize;
+    for (std::size_t i = asize; i-- > 0;) {
+        if (a[i] != b[i])
+            return a[i] < b[i];
+    }
+    return false;
+}
+
+template<typename Limb, Limb Base, typename Allocator>
+void basic_bigint<Limb, Base, Allocator>::mul_high_limbs(const number_type* a, std::size_t asize, const number_type* b, std::size_t bsize, number_type* out, std::size_t skip) noexcept
+{
+    for (std::size_t i = 0; i < asize; i++) {
+        DoubleWidthType carry = 0;
+        for (std::size_t j = skip > i ? (std::min)(skip - i, bsize) : 0; j < bsize; j++) {
+            const DoubleWidthType product = static_cast<DoubleWidthType>(a[i]) * static_cast<DoubleWidthType>(b[j]) +
+                carry + static_cast<DoubleWidthType>(out[i + j]);
+            carry = div_base(product, out[i + j]);
+        }
+        out[i + bsize] += static_cast<number_type>(carry);
+    }
+}
+
+template<typename Limb, Limb Base, typename Allocator>
+void basic_bigint<Limb, Base, Allocator>::mul_low_limbs(const number_type* a, std::size_t asize, const number_type* b, std::size_t bsize, number_type* out, std::size_t keep) noexcept
+{
+    for (std::size_t i = 0; i < asize && i < keep; i++) {
+        DoubleWidthType carry = 0;
+        std::size_t j = 0;
+        for (; j < bsize && i + j < keep; j++) {
+            const DoubleWidthType product = static_cast<DoubleWidthType>(a[i]) * static_cast<DoubleWidthType>(b[j]) +
+                carry + static_cast<DoubleWidthType>(out[i + j]);
+            carry = div_base(product, out[i + j]);
+        }
+        if (i + j < keep)
+            out[i + j] += static_cast<number_type>(carry);
+    }
+}
+
+template<typename Limb, Limb Base, typename Allocator>
+void basic_bigint<Limb, Base, Allocator>::mul_schoolbook(const number_type* a, std::size_t asize, const number_type* b, std::size_t bsize, number_type* out) noexcept
+{
+    for (std::size_t i = 0; i < asize; i++) {
+        DoubleWidthType carry = 0;
+        for (std::size_t j = 0; j < bsize; j++) {
+            const DoubleWidthType product = static_cast<DoubleWidthType>(a[i]) * static_cast<DoubleWidthType>(b[j]) +
+                carry + static_cast<DoubleWidthType>(out[i + j]);
+            carry = div_base(product, out[i + j]);
+        }
+        assert(carry < static_cast<DoubleWidthType>(kMaxDigitsInNumber));
+        out[i + bsize] += static_cast<number_type>(carry);
+    }
+}
+
+template<typename Limb, Limb Base, typename Allocator>
+void basic_bigint<Limb, Base, Allocator>::sqr_schoolbook(const number_type* a, std::size_t size, number_type* out) noexcept
+{
+    // cross products a[i] * a[j] with i < j, every one of them appears twice in the square
+    for (std::size_t i = 0; i < size; i++) {
+        DoubleWidthType carry = 0;
+        for (std::size_t j = i + 1; j < size; j++) {
+            const DoubleWidthType product = static_cast<DoubleWidthType>(a[i]) * static_cast<DoubleWidthType>(a[j]) +
+                carry + static_cast<DoubleWidthType>(out[i + j]);
+            carry = div_base(product, out[i + j]);
+        }
+        out[i + size] = static_cast<number_type>(carry);
+    }
+
+    DoubleWidthType carry = 0;
+    for (std::size_t i = 0; i < 2 * size; i++) {
+        const DoubleWidthType doubled = 2 * static_cast<DoubleWidthType>(out[i]) + carry;
+        carry = div_base(doubled, out[i]);
+    }
+    assert(carry == 0);
+
+    // and the squares on the diagonal
+    for (std::size_t i = 0; i < size; i++) {
+        const DoubleWidthType low = static_cast<DoubleWidthType>(a[i]) * static_cast<DoubleWidthType>(a[i]) +
+            carry + static_cast<DoubleWidthType>(out[2 * i]);
+        const DoubleWidthType high = div_base(low, out[2 * i]) + static_cast<DoubleWidthType>(out[2 * i + 1]);
+        carry = div_base(high, out[2 * i + 1]);
+    }
+    assert(carry == 0);
+}
+
+template<typename Limb, Limb Base, typename Allocator>
+void basic_bigint<Limb, Base, Allocator>::sqr_karatsuba(const number_type* a, std::size_t size, number_type* out, const allocator_type& alloc)
+{
+    // a = a1 * B^m + a0
+    // a^2 = a1^2 * B^2m + ((a1 + a0)^2 - a1^2 - a0^2) * B^m + a0^2
+    const std::size_t m = size / 2;
+    const std::size_t a1size = size - m;
+
+    sqr_limbs(a, m, out, alloc);
+    sqr_limbs(a + m, a1size, out + 2 * m, alloc);
+
+    storage_type asum(a + m, a1size, alloc);
+    asum.push_back(0);
+    add_limbs(&asum[0], asum.size(), a, m);
+    while (asum.size() > 1 && asum.back() == 0)
+        asum.pop_back();
+
+    storage_type z1((std::max)(2 * asum.size(), 2 * a1size), 0, alloc);
+    sqr_limbs(asum.data(), asum.size(), &z1[0], alloc);
+    sub_limbs(&z1[0], z1.size(), out, 2 * m);
+    sub_limbs(&z1[0], z1.size(), out + 2 * m, 2 * a1size);
+
+    std::size_t z1size = z1.size();
+    while (z1size > 0 && z1[z1size - 1] == 0)
+        --z1size;
+    add_limbs(out + m, 2 * size - m, z1.data(), z1size);
+}
+
+template<typename Limb, Limb Base, typename Allocator>
+void basic_bigint<Limb, Base, Allocator>::sqr_limbs(const number_type* a, std::size_t size, number_type* out, const allocator_type& alloc)
+{
+    if (size < kKaratsubaThreshold)
+        sqr_schoolbook(a, size, out);
+    else if (size < kToom3Threshold)
+        sqr_karatsuba(a, size, out, alloc);
+    else if (size >= kNttThreshold && 2 * size <= kNttMaxSize)
+        mul_ntt(a, size, a, size, out, alloc);
+    else if (size < kToom4Threshold)
+        mul_toom(a, size, a, size, out, 3, 3, alloc);
+    else
+        mul_toom(a, size, a, size, out, 4, 4, alloc);
+}
+
+template<typename Limb, Limb Base, typename Allocator>
+void basic_bigint<Limb, Base, Allocator>::mul_karatsuba(const number_type* a, std::size_t asize, const number_type* b, std::size_t bsize, number_type* out, const allocator_type& alloc)
+{
+    if (asize < bsize) {
+        std::swap(a, b);
+        std::swap(asize, bsize);
+    }
+
+    if (bsize < kKaratsubaThreshold) {
+        mul_schoolbook(a, asize, b, bsize, out);
+        return;
+    }
+
+    if (2 * bsize <= asize) {
+        mul_sliced(a, asize, b, bsize, out, alloc);
+        return;
+    }
+
+    // a = a1 * B^m + a0
+    // b = b1 * B^m + b0
+    // a * b = z2 * B^2m + (z1 - z2 - z0) * B^m + z0
+    // z1 = (a1 + a0) * (b1 + b0)
+    const std::size_t m = asize / 2;
+    const std::size_t a1size = asize - m;
+    const std::size_t b1size = bsize - m;
+
+    // z0 and z2 do not overlap so they go straight into out
+    mul_limbs(a, m, b, m, out, alloc);
+    mul_limbs(a + m, a1size, b + m, b1size, out + 2 * m, alloc);
+
+    storage_type asum(a + m, a1size, alloc);
+    asum.push_back(0);
+    add_limbs(&asum[0], asum.size(), a, m);
+
+    storage_type bsum(b + m, b1size, alloc);
+    bsum.resize((std::max)(b1size, m) + 1);
+    add_limbs(&bsum[0], bsum.size(), b, m);
+
+    // without trimming the carry limbs tiny thresholds would recurse forever
+    while (asum.size() > 1 && asum.back() == 0)
+        asum.pop_back();
+    while (bsum.size() > 1 && bsum.back() == 0)
+        bsum.pop_back();
+
+    storage_type z1((std::max)(asum.size() + bsum.size(), (std::max)(2 * m, a1size + b1size)), 0, alloc);
+    mul_limbs(asum.data(), asum.size(), bsum.data(), bsum.size(), &z1[0], alloc);
+    sub_limbs(&z1[0], z1.size(), out, 2 * m);
+    sub_limbs(&z1[0], z1.size(), out + 2 * m, a1size + b1size);
+
+    std::size_t z1size = z1.size();
+    while (z1size > 0 && z1[z1size - 1] == 0)
+        --z1size;
+    add_limbs(out + m, asize + bsize - m, z1.data(), z1size);
+}
+
+template<typename Limb, Limb Base, typename Allocator>
+basic_bigint<Limb, Base, Allocator> basic_bigint<Limb, Base, Allocator>::from_limbs(const number_type* limbs, std::size_t size, const allocator_type& alloc)
+{
+    bigint ret{ noinit_t{}, alloc };
+    ret.mNumbers.assign(limbs, limbs + size);
+    ret.fix();
+    return ret;
+}
+
+template<typename Limb, Limb Base, typename Allocator>
+typename basic_bigint<Limb, Base, Allocator>::DoubleWidthType basic_bigint<Limb, Base, Allocator>::div_limbs_small(number_type* r, std::size_t rsize, DoubleWidthType divisor) noexcept
+{
+    assert(divisor != 0 && divisor <= kMaxSmallDivisor);
+    return details::bigint::div_limbs_word(r, rsize, static_cast<DoubleWidthType>(kMaxDigitsInNumber), divisor);
+}
+
+namespace details { namespace bigint {
+
+// value of the polynomial whose coefficients are the k sized pieces of `a` at x.
+template<typename Bigint>
+Bigint toom_evaluate(const Bigint* pieces, std::size_t count, int x)
+{
+    if (x == 0)
+        return pieces[0];
+
+    Bigint ret = pieces[count - 1];
+    for (std::size_t i = count - 1; i-- > 0;) {
+        if (x != 1)
+            ret *= x;
+        ret += pieces[i];
+    }
+    return ret;
+}
+
+} } // namespace details::bigint
+
+template<typename Limb, Limb Base, typename Allocator>
+void basic_bigint<Limb, Base, Allocator>::mul_toom(const number_type* a, std::size_t asize, const number_type* b, std::size_t bsize, number_type* out, std::size_t apieces, std::size_t bpieces, const allocator_type& alloc)
+{
+    // a(x) = sum a_i * x^i and b(x) = sum b_i * x^i with x = B^k
+    // the product is evaluated at a few small points, multiplied pointwise
+    // and then the coefficients of a(x) * b(x) are interpolated back.
+    const std::size_t k = (std::max)((asize + apieces - 1) / apieces, (bsize + bpieces - 1) / bpieces);
+    const std::size_t points = apieces + bpieces - 2; // finite points, infinity is the top pieces
+
+    // evaluation points of the toom products, infinity is handled separately
+    static constexpr int kToomPoints[] = { 0, 1, -1, 2, -2, 3 };
+
+    // inverse vandermonde matrices for the points above, indexed by how many
+    // finite points are used (3 for toom-32, 4 for toom-33/42, 6 for toom-44).
+    // coefficient j of the product is
+    // sum(kToomNumerators[j][i] * (r(x_i) - r(inf) * x_i^points)) / kToomDenominators[j]
+    static constexpr int kToomDenominators3[] = { 1, 2, 2 };
+    static constexpr int kToomNumerators3[][6] = {
+        {  1, 0,  0 },
+        {  0, 1, -1 },
+        { -2, 1,  1 },
+    };
+
+    static constexpr int kToomDenominators4[] = { 1, 6, 2, 6 };
+    static constexpr int kToomNumerators4[][6] = {
+        {  1,  0,  0,  0 },
+        { -3,  6, -2, -1 },
+        { -2,  1,  1,  0 },
+        {  3, -3, -1,  1 },
+    };
+
+    static constexpr int kToomDenominators6[] = { 1, 60, 24, 24, 24, 120 };
+    static constexpr int kToomNumerators6[][6] = {
+        {   1,   0,   0,   0,  0, 0 },
+        { -20,  60, -30, -15,  3, 2 },
+        { -30,  16,  16,  -1, -1, 0 },
+        {  10, -14,  -1,   7, -1, -1 },
+        {   6,  -4,  -4,   1,  1, 0 },
+        { -10,  10,   5,  -5, -1, 1 },
+    };
+
+    const int* denominators = nullptr;
+    const int (*numerators)[6] = nullptr;
+    switch (points) {
+        case 3:
+            denominators = kToomDenominators3;
+            numerators = kToomNumerators3;
+            break;
+        case 4:
+            denominators = kToomDenominators4;
+            numerators = kToomNumerators4;
+            break;
+        case 6:
+            denominators = kToomDenominators6;
+            numerators = kToomNumerators6;
+            break;
+        default:
+            assert(false && "unsupported toom split");
+            unreachable();
+    }
+
+    // assignments keep the allocator of the target, so every piece and value starts out with alloc
+    bigint apiece[4] = { bigint{ alloc }, bigint{ alloc }, bigint{ alloc }, bigint{ alloc } };
+    bigint bpiece[4] = { bigint{ alloc }, bigint{ alloc }, bigint{ alloc }, bigint{ alloc } };
+    for (std::size_t i = 0; i < apieces; ++i) {
+        const std::size_t offset = (std::min)(i * k, asize);
+        apiece[i] = from_limbs(a + offset, (std::min)(k, asize - offset), alloc);
+    }
+    for (std::size_t i = 0; i < bpieces; ++i) {
+        const std::size_t offset = (std::min)(i * k, bsize);
+        bpiece[i] = from_limbs(b + offset, (std::min)(k, bsize - offset), alloc);
+    }
+
+    const bool square = a == b && asize == bsize && apieces == bpieces;
+    const bigint& atop = apiece[apieces - 1];
+    const bigint& btop = bpiece[bpieces - 1];
+    const bigint infinity = square ? sqr(atop) : mul(atop, btop, false, false);
+
+    bigint values[6] = { bigint{ alloc }, bigint{ alloc }, bigint{ alloc }, bigint{ alloc }, bigint{ alloc }, bigint{ alloc } };
+    for (std::size_t i = 0; i < points; ++i) {
+        const bigint x = details::bigint::toom_evaluate(apiece, apieces, kToomPoints[i]);
+        if (square) {
+            values[i] = sqr(x);
+        }
+        else {
+            const bigint y = details::bigint::toom_evaluate(bpiece, bpieces, kToomPoints[i]);
+            values[i] = mul(x, y, x.is_negative(), y.is_negative());
+        }
+        values[i] -= infinity * static_cast<int>(math::pow(kToomPoints[i], points));
+    }
+
+    const std::size_t outsize = asize + bsize;
+    for (std::size_t j = 0; j < points; ++j) {
+        bigint coefficient{ alloc };
+        for (std::size_t i = 0; i < points; ++i)
+            if (numerators[j][i] != 0)
+                coefficient += values[i] * numerators[j][i];
+
+        assert(!coefficient.is_negative());
+        if (denominators[j] != 1) {
+            const auto remainder = div_limbs_small(&coefficient.mNumbers[0], coefficient.mNumbers.size(), static_cast<number_type>(denominators[j]));
+            assert(remainder == 0);
+            static_cast<void>(remainder);
+            coefficient.fix();
+        }
+
+        if (coefficient)
+            add_limbs(out + j * k, outsize - j * k, coefficient.mNumbers.data(), coefficient.mNumbers.size());
+    }
+
+    if (infinity)
+        add_limbs(out + points * k, outsize - points * k, infinity.mNumbers.data(), infinity.mNumbers.size());
+}
+
+namespace details { namespace bigint {
+
+// primes of the form c * 2^k + 1 with 3 as a primitive root, all three
+// together bound the convolution of base 1e9 limbs up to 2^22 limbs.
+template<std::uint32_t Mod>
+struct ntt_prime {
+    static constexpr std::uint32_t mod = Mod;
+    static constexpr std::uint32_t generator = 3;
+
+    static std::uint32_t mul(std::uint32_t a, std::uint32_t b) noexcept
+    {
+        return static_cast<std::uint32_t>(static_cast<std::uint64_t>(a) * b % Mod);
+    }
+
+    static std::uint32_t pow(std::uint32_t base, std::uint64_t exponent) noexcept
+    {
+        std::uint32_t ret = 1;
+        while (exponent != 0) {
+            if (exponent & 1)
+                ret = mul(ret, base);
+            base = mul(base, base);
+            exponent >>= 1;
+        }
+        return ret;
+    }
+
+    static std::uint32_t inverse(std::uint32_t x) noexcept
+    {
+        return pow(x, Mod - 2);
+    }
+
+    // in place iterative transform, size must be a power of two
+    template<typename DigitAllocator>
+    static void transform(std::uint32_t* a, std::size_t size, bool invert, const DigitAllocator& alloc)
+    {
+        for (std::size_t i = 1, j = 0; i < size; ++i) {
+            std::size_t bit = size >> 1;
+            for (; j & bit; bit >>= 1)
+                j ^= bit;
+            j ^= bit;
+            if (i < j)
+                std::swap(a[i], a[j]);
+        }
+
+        // roots[i] = w^i where w is a primitive size-th root of unity
+        std::vector<std::uint32_t, DigitAllocator> roots(size / 2, 0, alloc);
+        const std::uint32_t w = pow(invert ? inverse(generator) : generator, (Mod - 1) / size);
+        if (!roots.empty())
+            roots[0] = 1;
+        for (std::size_t i = 1; i < roots.size(); ++i)
+            roots[i] = mul(roots[i - 1], w);
+
+        for (std::size_t length = 2; length <= size; length <<= 1) {
+            const std::size_t half = length / 2;
+            const std::size_t step = size / length;
+            for (std::size_t i = 0; i < size; i += length) {
+                for (std::size_t j = 0; j < half; ++j) {
+                    const std::uint32_t u = a[i + j];
+                    const std::uint32_t v = mul(a[i + j + half], roots[j * step]);
+                    a[i + j] = u + v < Mod ? u + v : u + v - Mod;
+                    a[i + j + half] = u >= v ? u - v : u + Mod - v;
+                }
+            }
+        }
+
+        if (invert) {
+            const std::uint32_t size_inverse = inverse(static_cast<std::uint32_t>(size % Mod));
+            for (std::size_t i = 0; i < size; ++i)
+                a[i] = mul(a[i], size_inverse);
+        }
+    }
+
+    template<typename Limb, typename DigitAllocator>
+    static std::vector<std::uint32_t, DigitAllocator> convolve(const Limb* a, std::size_t asize, const Limb* b, std::size_t bsize, std::size_t size, const DigitAllocator& alloc)
+    {
+        std::vector<std::uint32_t, DigitAllocator> fa(size, 0, alloc);
+        for (std::size_t i = 0; i < asize; ++i)
+            fa[i] = static_cast<std::uint32_t>(a[i] % Mod);
+        transform(fa.data(), size, false, alloc);
+
+        if (a == b && asize == bsize) {
+            // squaring, one forward transform is enough
+            for (std::size_t i = 0; i < size; ++i)
+                fa[i] = mul(fa[i], fa[i]);
+        }
+        else {
+            std::vector<std::uint32_t, DigitAllocator> fb(size, 0, alloc);
+            for (std::size_t i = 0; i < bsize; ++i)
+                fb[i] = static_cast<std::uint32_t>(b[i] % Mod);
+            transform(fb.data(), size, false, alloc);
+            for (std::size_t i = 0; i < size; ++i)
+                fa[i] = mul(fa[i], fb[i]);
+        }
+        transform(fa.data(), size, true, alloc);
+        return fa;
+    }
+};
+
+using ntt_prime1 = ntt_prime<998244353>; // 119 * 2^23 + 1
+using ntt_prime2 = ntt_prime<167772161>; //   5 * 2^25 + 1
+using ntt_prime3 = ntt_prime<469762049>; //   7 * 2^26 + 1
+
+// product of two base 1e9 digit sequences as base 1e9 digits, out holds asize + bsize zeroed digits,
+// the transforms are allocated by alloc
+template<typename Digit, typename Out, typename DigitAllocator>
+void ntt_multiply(const Digit* a, std::size_t asize, const Digit* b, std::size_t bsize, Out* out, const DigitAllocator& alloc)
+{
+    constexpr std::uint64_t kDigitBase = 1000000000;
+    const std::size_t outsize = asize + bsize;
+    std::size_t size = 1;
+    while (size < outsize)
+        size <<= 1;
+
+    const auto r1 = ntt_prime1::convolve(a, asize, b, bsize, size, alloc);
+    const auto r2 = ntt_prime2::convolve(a, asize, b, bsize, size, alloc);
+    const auto r3 = ntt_prime3::convolve(a, asize, b, bsize, size, alloc);
+
+    // garner's algorithm, x = r1 + p1 * v2 + p1 * p2 * v3
+    constexpr std::uint64_t p1 = ntt_prime1::mod;
+    constexpr std::uint64_t p2 = ntt_prime2::mod;
+    constexpr std::uint64_t p12 = p1 * p2;
+    constexpr std::uint64_t p12_high = p12 / kDigitBase;
+    constexpr std::uint64_t p12_low = p12 % kDigitBase;
+    const std::uint32_t p1_inverse = ntt_prime2::inverse(static_cast<std::uint32_t>(p1 % ntt_prime2::mod));
+    const std::uint32_t p12_inverse = ntt_prime3::inverse(static_cast<std::uint32_t>(p12 % ntt_prime3::mod));
+
+    std::uint64_t carry = 0;
+    for (std::size_t i = 0; i < outsize; ++i) {
+        const std::uint32_t x1 = r1[i];
+        const std::uint32_t x1_mod2 = static_cast<std::uint32_t>(x1 % ntt_prime2::mod);
+        const std::uint32_t v2 = ntt_prime2::mul(r2[i] >= x1_mod2 ? r2[i] - x1_mod2 : r2[i] + ntt_prime2::mod - x1_mod2, p1_inverse);
+        const std::uint64_t x12 = x1 + p1 * v2; // < p1 * p2
+
+        const std::uint32_t x12_mod3 = static_cast<std::uint32_t>(x12 % ntt_prime3::mod);
+        const std::uint64_t v3 = ntt_prime3::mul(r3[i] >= x12_mod3 ? r3[i] - x12_mod3 : r3[i] + ntt_prime3::mod - x12_mod3, p12_inverse);
+
+        // x + carry = x12 + carry + v3 * p12_low + v3 * p12_high * 1e9
+        const std::uint64_t low = x12 + carry + v3 * p12_low;
+        out[i] = static_cast<std::uint32_t>(low % kDigitBase);
+        carry = low / kDigitBase + v3 * p12_high;
+    }
+    assert(carry == 0);
+}
+
+} } // namespace details::bigint
+
+template<typename Limb, Limb Base, typename Allocator>
+void basic_bigint<Limb, Base, Allocator>::mul_ntt(const number_type* a, std::size_t asize, const number_type* b, std::size_t bsize, number_type* out, const allocator_type& alloc)
+{
+    assert(asize + bsize <= kNttMaxSize);
+    // the ntt primes are chosen for base 1e9, every limb goes in as kSplit digits of 1e9
+    constexpr std::size_t kSplit = kDigitCountOfMax / 9 == 0 ? 1 : kDigitCountOfMax / 9;
+    using digit_allocator = typename std::allocator_traits<Allocator>::template rebind_alloc<std::uint32_t>;
+    const digit_allocator digit_alloc(alloc);
+    if (kSplit == 1) {
+        details::bigint::ntt_multiply(a, asize, b, bsize, out, digit_alloc);
+        return;
+    }
+
+    constexpr number_type kDigitBase = 1000000000;
+    std::vector<std::uint32_t, digit_allocator> digits(kSplit * (asize + bsize), 0, digit_alloc);
+    for (std::size_t i = 0; i < asize; ++i) {
+        number_type limb = a[i];
+        for (std::size_t j = 0; j < kSplit; ++j, limb /= kDigitBase)
+            digits[kSplit * i + j] = static_cast<std::uint32_t>(limb % kDigitBase);
+    }
+    std::uint32_t* bdigits = &digits[kSplit * asize];
+    for (std::size_t i = 0; i < bsize; ++i) {
+        number_type limb = b[i];
+        for (std::size_t j = 0; j < kSplit; ++j, limb /= kDigitBase)
+            bdigits[kSplit * i + j] = static_cast<std::uint32_t>(limb % kDigitBase);
+    }
+
+    std::vector<std::uint32_t, digit_allocator> product(kSplit * (asize + bsize), 0, digit_alloc);
+    details::bigint::ntt_multiply(digits.data(), kSplit * asize, bdigits, kSplit * bsize, product.data(), digit_alloc);
+    for (std::size_t i = 0; i < asize + bsize; ++i) {
+        number_type limb = 0;
+        for (std::size_t j = kSplit; j-- > 0;)
+            limb = limb * kDigitBase + product[kSplit * i + j];
+        out[i] = limb;
+    }
+}
+
+template<typename Limb, Limb Base, typename Allocator>
+void basic_bigint<Limb, Base, Allocator>::mul_sliced(const number_type* a, std::size_t asize, const number_type* b, std::size_t bsize, number_type* out, const allocator_type& alloc)
+{
+    // unbalanced, multiply b by slices of a that are as big as b
+    assert(bsize <= asize);
+    storage_type product(2 * bsize, 0, alloc);
+    for (std::size_t offset = 0; offset < asize; offset += bsize) {
+        const std::size_t size = (std::min)(bsize, asize - offset);
+        std::fill(product.begin(), product.end(), 0);
+        mul_limbs(a + offset, size, b, bsize, &product[0], alloc);
+        add_limbs(out + offset, asize + bsize - offset, product.data(), size + bsize);
+    }
+}
+
+template<typename Limb, Limb Base, typename Allocator>
+void basic_bigint<Limb, Base, Allocator>::mul_limbs(const number_type* a, std::size_t asize, const number_type* b, std::size_t bsize, number_type* out, const allocator_type& alloc)
+{
+    if (a == b && asize == bsize) {
+        sqr_limbs(a, asize, out, alloc);
+        return;
+    }
+
+    if (asize < bsize) {
+        std::swap(a, b);
+        std::swap(asize, bsize);
+    }
+
+    if (bsize < kKaratsubaThreshold)
+        mul_schoolbook(a, asize, b, bsize, out);
+    else if (bsize < kToom3Threshold)
+        mul_karatsuba(a, asize, b, bsize, out, alloc);
+    else if (bsize >= kNttThreshold && asize + bsize <= kNttMaxSize)
+        mul_ntt(a, asize, b, bsize, out, alloc);
+    else if (asize >= 3 * bsize)
+        mul_sliced(a, asize, b, bsize, out, alloc);
+    else if (asize >= 2 * bsize)
+        mul_toom(a, asize, b, bsize, out, 4, 2, alloc);
+    else if (2 * asize >= 3 * bsize)
+        mul_toom(a, asize, b, bsize, out, 3, 2, alloc);
+    else if (bsize < kToom4Threshold)
+        mul_toom(a, asize, b, bsize, out, 3, 3, alloc);
+    else
+        mul_toom(a, asize, b, bsize, out, 4, 4, alloc);
+}
+
+template<typename Limb, Limb Base, typename Allocator>
+basic_bigint<Limb, Base, Allocator> basic_bigint<Limb, Base, Allocator>::div(const bigint& a, const bigint& b, bool a_negative, bool b_negative)
+{
+    if (!b)
+        throw std::invalid_argument("zxshady::bigint::operator/ Division by zero.");
+
+    // if the abs(a) is less than abs(b), the quotient is 0
+    if (bigint::lt(a, b, false, false)) {
+        return bigint{ a.get_allocator() };
+    }
+
+    const auto asize = a.mNumbers.size();
+    const auto bsize = b.mNumbers.size();
+    bigint ret{ noinit_t{}, a.get_allocator() };
+    ret.mNumbers.resize(asize - bsize + 1);
+    div_limbs(a.mNumbers.data(), asize, b.mNumbers.data(), bsize, &ret.mNumbers[0], nullptr, ret.get_allocator());
+
+    ret.mIsNegative = a_negative != b_negative;
+    ret.fix();
+    return ret;
+}
+
+template<typename Limb, Limb Base, typename Allocator>
+void basic_bigint<Limb, Base, Allocator>::div_limbs(const number_type* a, std::size_t asize, const number_type* b, std::size_t bsize, number_type* quotient, number_type* remainder, const allocator_type& alloc)
+{
+    assert(asize >= bsize && bsize != 0 && b[bsize - 1] != 0);
+
+    if (bsize >= kNewtonThreshold && asize - bsize >= kNewtonThreshold)
+        div_newton(a, asize, b, bsize, quotient, remainder, alloc);
+    else if (bsize >= kBurnikelZieglerThreshold && asize - bsize >= kBurnikelZieglerThreshold)
+        div_burnikel_ziegler(a, asize, b, bsize, quotient, remainder, alloc);
+    else
+        div_schoolbook(a, asize, b, bsize, quotient, remainder, alloc);
+}
+
+template<typename Limb, Limb Base, typename Allocator>
+basic_bigint<Limb, Base, Allocator> basic_bigint<Limb, Base, Allocator>::limb_slice(const bigint& x, std::size_t first, std::size_t last)
+{
+    const auto size = x.mNumbers.size();
+    if (first >= size)
+        return bigint{ x.get_allocator() };
+    return from_limbs(x.mNumbers.data() + first, (std::min)(last, size) - first, x.get_allocator());
+}
+
+template<typename Limb, Limb Base, typename Allocator>
+basic_bigint<Limb, Base, Allocator> basic_bigint<Limb, Base, Allocator>::concat_limbs(bigint high, const bigint& low, std::size_t n)
+{
+    assert(low.mNumbers.size() <= n);
+    if (!high)
+        return low;
+    high.mNumbers.insert(0, n, 0);
+    if (low)
+        std::copy(low.mNumbers.begin(), low.mNumbers.end(), high.mNumbers.begin());
+    return high;
+}
+
+template<typename Limb, Limb Base, typename Allocator>
+void basic_bigint<Limb, Base, Allocator>::div_burnikel_ziegler(const number_type* a, std::size_t asize, const number_type* b, std::size_t bsize, number_type* quotient, number_type* remainder, const allocator_type& alloc)
+{
+    // pad the divisor to n = j * 2^k limbs so div_2n_1n can halve it down
+    // to the long division threshold, and normalize its top limb.
+    std::size_t m = 1;
+    while (m * kBurnikelZieglerThreshold <= bsize)
+        m *= 2;
+    const std::size_t j = (bsize + m - 1) / m;
+    const std::size_t n = j * m;
+    const std::size_t shift = n - bsize;
+    const number_type scale = static_cast<number_type>(kMaxDigitsInNumber / (static_cast<DoubleWidthType>(b[bsize - 1]) + 1));
+
+    bigint divisor = from_limbs(b, bsize, alloc) * scale;
+    bigint dividend = from_limbs(a, asize, alloc) * scale;
+    divisor.mNumbers.insert(0, shift, 0);
+    dividend.mNumbers.insert(0, shift, 0);
+    assert(divisor.mNumbers.size() == n);
+
+    // the top block gets at least one zero limb so it is smaller than the divisor
+    const std::size_t blocks = (std::max)(std::size_t{ 2 }, (dividend.mNumbers.size() + n) / n);
+
+    bigint z = limb_slice(dividend, (blocks - 2) * n, blocks * n);
+    bigint q{ alloc };
+    bigint r{ alloc };
+    std::fill(quotient, quotient + (asize - bsize + 1), 0);
+    for (std::size_t i = blocks - 1; i-- > 0;) {
+        div_2n_1n(z, divisor, n, q, r);
+
+        // every block quotient is below B^n, place it at limb i * n
+        if (q) {
+            assert(i * n + q.mNumbers.size() <= asize - bsize + 1);
+            std::copy(q.mNumbers.begin(), q.mNumbers.end(), quotient + i * n);
+        }
+
+        if (i != 0)
+            z = concat_limbs(std::move(r), limb_slice(dividend, (i - 1) * n, i * n), n);
+    }
+
+    if (remainder) {
+        std::fill(remainder, remainder + bsize, 0);
+        if (r) {
+            r.mNumbers.erase(0, shift);
+            div_limbs_small(&r.mNumbers[0], r.mNumbers.size(), scale);
+            std::copy(r.mNumbers.begin(), r.mNumbers.end(), remainder);
+        }
+    }
+}
+
+template<typename Limb, Limb Base, typename Allocator>
+void basic_bigint<Limb, Base, Allocator>::div_2n_1n(const bigint& a, const bigint& b, std::size_t n, bigint& quotient, bigint& remainder)
+{
+    // a < B^n * b
+    if (n % 2 != 0 || n < kBurnikelZieglerThreshold) {
+        if (bigint::lt(a, b, false, false)) {
+            quotient.zero();
+            remainder = a;
+            return;
+        }
+        const auto asize = a.mNumbers.size();
+        const auto bsize = b.mNumbers.size();
+        quotient.mNumbers.assign(asize - bsize + 1, 0);
+        remainder.mNumbers.assign(bsize, 0);
+        div_schoolbook(a.mNumbers.data(), asize, b.mNumbers.data(), bsize, &quotient.mNumbers[0], &remainder.mNumbers[0], quotient.get_allocator());
+        quotient.mIsNegative = remainder.mIsNegative = false;
+        quotient.fix();
+        remainder.fix();
+        return;
+    }
+
+    const std::size_t half = n / 2;
+    bigint q1{ a.get_allocator() };
+    bigint r{ a.get_allocator() };
+    div_3n_2n(limb_slice(a, half, 4 * half), b, half, q1, r);
+
+    // r * B^half + the lowest block of a
+    div_3n_2n(concat_limbs(std::move(r), limb_slice(a, 0, half), half), b, half, quotient, remainder);
+
+    if (q1) {
+        q1.mNumbers.insert(0, half, 0);
+        quotient += q1;
+    }
+}
+
+template<typename Limb, Limb Base, typename Allocator>
+void basic_bigint<Limb, Base, Allocator>::div_3n_2n(const bigint& a, const bigint& b, std::size_t n, bigint& quotient, bigint& remainder)
+{
+    // a < B^n * b, b has 2n limbs
+    const bigint b1 = limb_slice(b, n, 2 * n);
+    const bigint b2 = limb_slice(b, 0, n);
+    const bigint a12 = limb_slice(a, n, 3 * n);
+
+    bigint r1{ a.get_allocator() };
+    if (bigint::lt(limb_slice(a, 2 * n, 3 * n), b1, false, false)) {
+        div_2n_1n(a12, b1, n, quotient, r1);
+    }
+    else {
+        // the top blocks are equal, the quotient is B^n - 1 and a12 - quotient * b1 == a12 - b1 * B^n + b1
+        quotient.mNumbers.assign(n, kMaxDigitsInNumber - 1);
+        quotient.mIsNegative = false;
+        bigint shifted = b1;
+        shifted.mNumbers.insert(0, n, 0);
+        r1 = a12 - shifted + b1;
+    }
+
+    // remainder = r1 * B^n + a3 - quotient * b2, corrected by adding b back while negative
+    const bigint d = quotient * b2;
+    remainder = concat_limbs(std::move(r1), limb_slice(a, 0, n), n);
+    while (bigint::lt(remainder, d, false, false)) {
+        remainder += b;
+        quotient -= 1;
+    }
+    remainder -= d;
+}
+
+template<typename Limb, Limb Base, typename Allocator>
+void basic_bigint<Limb, Base, Allocator>::div_newton(const number_type* a, std::size_t asize, const number_type* b, std::size_t bsize, number_type* quotient, number_type* remainder, const allocator_type& alloc)
+{
+    const bigint divisor = from_limbs(b, bsize, alloc);
+    const bigint dividend = from_limbs(a, asize, alloc);
+
+    // a * (B^asize / b) / B^asize is at most a few units off the quotient, the
+    // lowest bsize - 2 limbs of a only change that by less than one.
+    const std::size_t dropped = bsize - 2;
+    bigint q = limb_slice(limb_slice(dividend, dropped, asize) * reciprocal_limbs(divisor, asize), asize - dropped, std::size_t(-1));
+    bigint r = dividend - q * divisor;
+    while (r.is_negative()) {
+        r += divisor;
+        --q;
+    }
+    while (!bigint::lt(r, divisor, false, false)) {
+        r -= divisor;
+        ++q;
+    }
+
+    assert(q.mNumbers.size() <= asize - bsize + 1 && r.mNumbers.size() <= bsize);
+    std::fill(quotient, quotient + (asize - bsize + 1), 0);
+    std::copy(q.mNumbers.begin(), q.mNumbers.end(), quotient);
+    if (remainder) {
+        std::fill(remainder, remainder + bsize, 0);
+        std::copy(r.mNumbers.begin(), r.mNumbers.end(), remainder);
+    }
+}
+
+template<typename Limb, Limb Base, typename Allocator>
+basic_bigint<Limb, Base, Allocator> basic_bigint<Limb, Base, Allocator>::reciprocal_limbs(const bigint& d, std::size_t k)
+{
+    const std::size_t n = d.mNumbers.size();
+    assert(k >= n && !d.is_negative());
+    const std::size_t p = k - n;
+
+    // below the threshold bigint::div does not come back here, and
+    // the newton step below needs p / 2 + 2 < p
+    static_assert(kNewtonThreshold >= 16, "ZXSHADY_BIGINT_NEWTON_THRESHOLD must be at least 16");
+    if (p + 1 < kNewtonThreshold || n < kNewtonThreshold) {
+        bigint power{ noinit_t{}, d.get_allocator() };
+        power.mNumbers.assign(k + 1, 0);
+        power.mNumbers[k] = 1;
+        return bigint::div(power, d, false, false);
+    }
+
+    // y = B^(t + l) / (top t limbs of d) is correct to about l limbs,
+    // then one newton step x = x + x * (B^k - d * x) / B^k doubles that.
+    const std::size_t l = p / 2 + 2;
+    const std::size_t t = (std::min)(n, l + 2);
+    const std::size_t s = n - t;
+    const std::size_t e = p - l;
+    const bigint y = reciprocal_limbs(limb_slice(d, s, n), t + l);
+
+    // with x = y * B^e the step becomes y * B^e + y * (B^(k - e) - d * y) / B^(k - 2e),
+    // y has at most l + 1 limbs so the error limbs below B^(k - 2e - l - 2) don't matter.
+    bigint error{ noinit_t{}, d.get_allocator() };
+    error.mNumbers.assign(k - e + 1, 0);
+    error.mNumbers[k - e] = 1;
+    error -= d * y;
+
+    const std::size_t ignored = k - 2 * e > l + 2 ? k - 2 * e - l - 2 : 0;
+    bigint truncated = limb_slice(error, ignored, std::size_t(-1));
+    truncated.set_sign(error.is_negative());
+    const bigint correction = y * truncated;
+    bigint ret = limb_slice(correction, k - 2 * e - ignored, std::size_t(-1));
+    ret.set_sign(correction.is_negative());
+    bigint shifted = y;
+    shifted.mNumbers.insert(0, e, 0);
+    ret += shifted;
+    return ret;
+}
+
+template<typename Limb, Limb Base, typename Allocator>
+basic_bigint<Limb, Base, Allocator> basic_bigint<Limb, Base, Allocator>::div_pow10(const bigint& x, std::size_t exponent)
+{
+    bigint ret = limb_slice(x, exponent / kDigitCountOfMax, std::size_t(-1));
+    if (exponent % kDigitCountOfMax != 0) {
+        div_limbs_small(&ret.mNumbers[0], ret.mNumbers.size(), static_cast<number_type>(math::pow10(exponent % kDigitCountOfMax)));
+        ret.fix();
+    }
+    return ret;
+}
+
+template<typename Limb, Limb Base, typename Allocator>
+void basic_bigint<Limb, Base, Allocator>::div_schoolbook(const number_type* a, std::size_t asize, const number_type* b, std::size_t bsize, number_type* quotient, number_type* remainder, const allocator_type& alloc)
+{
+    assert(asize >= bsize && bsize != 0 && b[bsize - 1] != 0);
+
+    if (bsize == 1) {
+        std::copy(a, a + asize, quotient);
+        const auto r = static_cast<number_type>(div_limbs_small(quotient, asize, b[0]));
+        if (remainder)
+            remainder[0] = r;
+        return;
+    }
+
+    // normalize so the top limb of the divisor is at least B / 2,
+    // that keeps every estimated quotient limb at most 2 too big.
+    const number_type scale = static_cast<number_type>(kMaxDigitsInNumber / (static_cast<DoubleWidthType>(b[bsize - 1]) + 1));
+    storage_type u(asize + 1, 0, alloc);
+    storage_type v(bsize, 0, alloc);
+    std::copy(a, a + asize, u.begin());
+    std::copy(b, b + bsize, v.begin());
+    if (scale != 1) {
+        DoubleWidthType carry = 0;
+        for (std::size_t i = 0; i < asize; ++i) {
+            const DoubleWidthType product = static_cast<DoubleWidthType>(u[i]) * scale + carry;
+            carry = div_base(product, u[i]);
+        }
+        u[asize] = static_cast<number_type>(carry);
+
+        carry = 0;
+        for (std::size_t i = 0; i < bsize; ++i) {
+            const DoubleWidthType product = static_cast<DoubleWidthType>(v[i]) * scale + carry;
+            carry = div_base(product, v[i]);
+        }
+        assert(carry == 0);
+    }
+
+    const DoubleWidthType vtop = v[bsize - 1];
+    const DoubleWidthType vnext = v[bsize - 2];
+    for (std::size_t j = asize - bsize + 1; j-- > 0;) {
+        // estimate the quotient limb from the top two limbs of the remainder
+        const DoubleWidthType top = static_cast<DoubleWidthType>(u[j + bsize]) * kMaxDigitsInNumber + u[j + bsize - 1];
+        DoubleWidthType qhat = top / vtop;
+        DoubleWidthType rhat = top % vtop;
+        while (qhat >= kMaxDigitsInNumber || qhat * vnext > rhat * kMaxDigitsInNumber + u[j + bsize - 2]) {
+            --qhat;
+            rhat += vtop;
+            if (rhat >= kMaxDigitsInNumber)
+                break;
+        }
+
+        // u[j .. j + bsize] -= qhat * v
+        DoubleWidthType carry = 0;
+        std::int64_t borrow = 0;
+        for (std::size_t i = 0; i < bsize; ++i) {
+            number_type low;
+            carry = div_base(qhat * v[i] + carry, low);
+            std::int64_t diff = static_cast<std::int64_t>(u[i + j]) - static_cast<std::int64_t>(low) - borrow;
+            borrow = diff < 0;
+            if (diff < 0)
+                diff += kMaxDigitsInNumber;
+            u[i + j] = static_cast<number_type>(diff);
+        }
+        std::int64_t diff = static_cast<std::int64_t>(u[j + bsize]) - static_cast<std::int64_t>(carry) - borrow;
+
+        if (diff < 0) {
+            // qhat was one too big, adding v back brings the top limb back to zero
+            --qhat;
+            const number_type carry_out = add_limbs(&u[j], bsize, v.data(), bsize);
+            assert(diff + carry_out == 0);
+            static_cast<void>(carry_out);
+            u[j + bsize] = 0;
+        }
+        else {
+            u[j + bsize] = static_cast<number_type>(diff);
+        }
+        quotient[j] = static_cast<number_type>(qhat);
+    }
+
+    if (remainder) {
+        div_limbs_small(&u[0], bsize, scale);
+        std::copy(u.begin(), u.begin() + static_cast<std::ptrdiff_t>(bsize), remainder);
+    }
+}
+
+template<typename Limb, Limb Base, typename Allocator>
+std::pair<basic_bigint<Limb, Base, Allocator>, basic_bigint<Limb, Base, Allocator>> basic_bigint<Limb, Base, Allocator>::divmod(const bigint& a, const bigint& b)
+{
+    std::pair<bigint, bigint> ret{ bigint{ a.get_allocator() }, bigint{ a.get_allocator() } };
+    bigint::divmod(a, b, ret.first, ret.second);
+    return ret;
+}
+
+template<typename Limb, Limb Base, typename Allocator>
+void basic_bigint<Limb, Base, Allocator>::divmod(const bigint& a, const bigint& b, bigint& quotient, bigint& remainder)
+{
+    if (!b)
+        throw std::invalid_argument("zxshady::bigint::divmod Division by zero.");
+
+    // if the abs(a) is less than abs(b), the quotient is 0
+    if (bigint::lt(a, b, false, false)) {
+        remainder = a;
+        quotient.zero();
+        return;
+    }
+
+    if (&quotient == &a || &quotient == &b || &remainder == &a || &remainder == &b) {
+        bigint q{ quotient.get_allocator() };
+        bigint r{ remainder.get_allocator() };
+        bigint::divmod(a, b, q, r);
+        quotient = std::move(q);
+        remainder = std::move(r);
+        return;
+    }
+
+    const auto asize = a.mNumbers.size();
+    const auto bsize = b.mNumbers.size();
+    quotient.mNumbers.resize(asize - bsize + 1);
+    remainder.mNumbers.resize(bsize);
+    div_limbs(a.mNumbers.data(), asize, b.mNumbers.data(), bsize, &quotient.mNumbers[0], &remainder.mNumbers[0], quotient.get_allocator());
+
+    quotient.mIsNegative = a.is_negative() != b.is_negative();
+    remainder.mIsNegative = a.is_negative();
+    quotient.fix();
+    remainder.fix();
+}
+
+template<typename Limb, Limb Base, typename Allocator>
+std::uint64_t basic_bigint<Limb, Base, Allocator>::mod_small(std::uint64_t divisor) const
+{
+    if (divisor == 0)
+        throw std::invalid_argument("zxshady::bigint::mod_small(std::uint64_t divisor) Division by zero.");
+
+    if (divisor > kMaxSmallDivisor) {
+        bigint remainder = abs(*this) % bigint(divisor);
+        return remainder.to<std::uint64_t>();
+    }
+
+    return static_cast<std::uint64_t>(details::bigint::mod_limbs_word(mNumbers.data(), mNumbers.size(), static_cast<DoubleWidthType>(kMaxDigitsInNumber), static_cast<DoubleWidthType>(divisor)));
+}
+
+template<typename Limb, Limb Base, typename Allocator>
+bool basic_bigint<Limb, Base, Allocator>::lt(const bigint& a, const bigint& b,bool a_negative,bool b_negative) noexcept
+{
+    // if not same sign...
+    if (a_negative != b_negative)
+        return a_negative;
+
+    // if not same size
+    const auto asize = a.mNumbers.size();
+    const auto bsize = b.mNumbers.size();
+
+    if (asize != bsize)
+        return (asize < bsize) != a_negative;
+
+    // Compare digits starting from the most significant
+    const auto end = a.mNumbers.crend();
+    auto it1 = a.mNumbers.crbegin();
+    auto it2 = b.mNumbers.crbegin();
+
+    
+    // void() to prevent overloading of comma operator :P
+    for (; it1 != end; ++it1, void(), ++it2) {
+        const auto x = *it1;
+        const auto y = *it2;
+        if (x != y)
+            return (x < y) != a_negative;
+    }
+    return false;
+}
+template<typename Limb, Limb Base, typename Allocator>
+basic_bigint<Limb, Base, Allocator>& basic_bigint<Limb, Base, Allocator>::half() & noexcept
+{
+    number_type remainder = 0;
+    for (std::size_t i = mNumbers.size(); i-- > 0;) {
+        const number_type current = mNumbers[i] + remainder * kMaxDigitsInNumber;
+        mNumbers[i] = current / 2;
+        remainder = current % 2;
+    }
+
+    this->fix();
+    return *this;
+}
+
+template<typename Limb, Limb Base, typename Allocator>
+basic_bigint<Limb, Base, Allocator>& basic_bigint<Limb, Base, Allocator>::mul_2exp(unsigned long long exponent) &
+{
+    if (!*this || exponent == 0)
+        return *this;
+
+    if (exponent > kMaxShiftPerPass)
+        return *this *= pow_window(bigint(2, get_allocator()), exponent);
+
+    DoubleWidthType carry = 0;
+    for (auto& limb : mNumbers) {
+        const DoubleWidthType current = (static_cast<DoubleWidthType>(limb) << exponent) + carry;
+        limb = static_cast<number_type>(current % kMaxDigitsInNumber);
+        carry = current / kMaxDigitsInNumber;
+    }
+    while (carry != 0) {
+        mNumbers.push_back(static_cast<number_type>(carry % kMaxDigitsInNumber));
+        carry /= kMaxDigitsInNumber;
+    }
+    return *this;
+}
+
+template<typename Limb, Limb Base, typename Allocator>
+basic_bigint<Limb, Base, Allocator>& basic_bigint<Limb, Base, Allocator>::div_2exp(unsigned long long exponent) &
+{
+    if (!*this || exponent == 0)
+        return *this;
+
+    // 2^exponent has more digits than *this
+    if (exponent / 4 > digit_count()) {
+        zero();
+        return *this;
+    }
+
+    if (exponent <= kMaxShiftPerPass) {
+        div_limbs_small(&mNumbers[0], mNumbers.size(), DoubleWidthType{ 1 } << exponent);
+        fix();
+        return *this;
+    }
+
+    // x / 2^k == x * 5^k / 10^k, one multiplication instead of k / kMaxShiftPerPass passes
+    const bool was_negative = is_negative();
+    *this = div_pow10(*this * pow_window(bigint(5, get_allocator()), exponent), static_cast<std::size_t>(exponent));
+    set_sign(was_negative);
+    return *this;
+}
+
+template<typename Limb, Limb Base, typename Allocator>
+basic_bigint<Limb, Base, Allocator>& basic_bigint<Limb, Base, Allocator>::double_() & 
+{
+    number_type carry = 0;
+
+    const std::size_t size = mNumbers.size();
+    for (std::size_t i = 0; i < size; ++i) {
+        number_type sum = carry;
+        sum += 2 * mNumbers[i];
+        mNumbers[i] = sum % kMaxDigitsInNumber;
+        carry = sum / kMaxDigitsInNumber;
+    }
+    if (carry > 0)
+        mNumbers.push_back(carry);
+    return *this;
+}
+
+
+
+template<typename Limb, Limb Base, typename Allocator>
+basic_bigint<Limb, Base, Allocator> basic_bigint<Limb, Base, Allocator>::rand(std::size_t num_digits /* = 1000 */)
+{
+    if(num_digits == 0)
+        throw std::invalid_argument("zxshady::bigint::rand(size_t num_digits) num_digits must be non-zero");
+
+    bigint ret{ noinit_t{} };
+    std::size_t total = 0;
+    while (total != num_digits) {
+        // 21
+        auto rand = static_cast<number_type>(std::rand());
+        while(rand <= kMaxDigitsInNumber)
+            rand *= static_cast<number_type>(std::rand());
+
+        // 13049831058
+        rand %= kMaxDigitsInNumber;
+        if(rand == 0)
+            rand = 1;
+
+        if(rand % 25 == 0){
+            ret.flip_sign();
+        }
+        total += kDigitCountOfMax;
+        if (total > num_digits) {
+            total -= kDigitCountOfMax;
+            total += zxshady::math::digit_count(rand);
+        }
+        ret.mNumbers.push_back(rand);
+
+        while(total > num_digits){
+            auto& back = ret.mNumbers.back();
+            back /=10;
+            --total;
+        }
+    }
+    ret.fix();
+    assert(ret.digit_count() == num_digits);
+    return ret;
+}
+template<typename Limb, Limb Base, typename Allocator>
+unsigned long long log2(const basic_bigint<Limb, Base, Allocator>& x)
+{
+    if(!x)
+        throw std::invalid_argument("zxshady::bigint::log2(const bigint& x) input cannot be 0");
+
+    if(x.is_negative())
+        throw std::invalid_argument("zxshady::bigint::log2(const bigint& x) input cannot be negative");
+
+    return x.bit_length() - 1;
+}
+template<typename Limb, Limb Base, typename Allocator>
+unsigned long long log10(const basic_bigint<Limb, Base, Allocator>& x)
+{
+    if(!x)
+        throw std::invalid_argument("zxshady::bigint::log10(bigint x) input cannot be 0");
+    if(x.is_negative())
+        throw std::invalid_argument("zxshady::bigint::log10(bigint x) input cannot be negative");
+
+    return x.digit_count() - 1;
+}
+template<typename Limb, Limb Base, typename Allocator>
+unsigned long long log(const basic_bigint<Limb, Base, Allocator>& x,unsigned long long base )
+{
+    if(!x)
+        throw std::invalid_argument("zxshady::bigint::log(bigint x,unsigned long long base) x cannot be 0");
+
+    if(x.is_negative())
+        throw std::invalid_argument("zxshady::bigint::log(bigint x,unsigned long long base) x cannot be negative");
+
+    if(base <= 1)
+        throw std::invalid_argument("zxshady::bigint::log(bigint x,unsigned long long base) base cannot be less than or equal to 1");
+
+
+    return static_cast<unsigned long long>(static_cast<double>(log10(x)) / std::log10(base));
+}
+namespace details { namespace bigint {
+
+// calls f(p) for the primes p up to n in order, sieving only the odd numbers
+template<typename Function>
+void for_each_prime(std::uint32_t n, Function f)
+{
+    if (n < 2)
+        return;
+
+    f(std::uint32_t{ 2 });
+    std::vector<bool> composite(n / 2 + 1); // composite[i] is about 2i + 1
+    for (std::uint64_t i = 3; i <= n; i += 2) {
+        if (composite[i / 2])
+            continue;
+        f(static_cast<std::uint32_t>(i));
+        for (std::uint64_t j = i * i; j <= n; j += 2 * i)
+            composite[j / 2] = true;
+    }
+}
+
+inline std::vector<std::uint32_t> primes_up_to(std::uint32_t n)
+{
+    std::vector<std::uint32_t> primes;
+    for_each_prime(n, [&primes](std::uint32_t p) { primes.push_back(p); });
+    return primes;
+}
+
+// product of words[first, last), splitting in halves keeps the operands of the
+// big multiplications the same size so they reach the fast kernels
+template<typename Bigint, typename T>
+Bigint product_tree(const std::vector<T>& words, std::size_t first, std::size_t last)
+{
+    if (last - first <= 16) {
+        Bigint ret{ 1 };
+        for (std::size_t i = first; i < last; ++i)
+            ret *= words[i];
+        return ret;
+    }
+    const std::size_t middle = first + (last - first) / 2;
+    return product_tree<Bigint>(words, first, middle) * product_tree<Bigint>(words, middle, last);
+}
+
+// collects small factors, multiplying them together into words below 10^18
+// so the product tree starts from fewer and fuller leaves
+template<typename Bigint>
+class factor_list {
+public:
+    void push(std::uint64_t factor)
+    {
+        if (mCurrent != 1 && mCurrent > kWordLimit / factor) {
+            mWords.push_back(mCurrent);
+            mCurrent = factor;
+        }
+        else {
+            mCurrent *= factor;
+        }
+    }
+
+    Bigint product()
+    {
+        if (mCurrent != 1)
+            mWords.push_back(mCurrent);
+        mCurrent = 1;
+        return product_tree<Bigint>(mWords, 0, mWords.size());
+    }
+
+private:
+    static constexpr std::uint64_t kWordLimit = 1000000000000000000ULL;
+    std::vector<std::uint64_t> mWords;
+    std::uint64_t mCurrent = 1;
+};
+
+// n! / ((n / 2)!)^2, the exponent of p in it is the number of odd n / p^i (i >= 1)
+template<typename Bigint>
+Bigint prime_swing(std::uint32_t n, const std::vector<std::uint32_t>& primes)
+{
+    factor_list<Bigint> factors;
+    for (const auto p : primes) {
+        if (p > n)
+            break;
+        std::uint64_t power = 1; // at most n
+        for (std::uint32_t q = n / p; q != 0; q /= p) {
+            if (q % 2 == 1)
+                power *= p;
+        }
+        if (power != 1)
+            factors.push(power);
+    }
+    return factors.product();
+}
+
+// luschny's prime swing: n! = ((n / 2)!)^2 * swing(n)
+template<typename Bigint>
+Bigint factorial(std::uint32_t n, const std::vector<std::uint32_t>& primes)
+{
+    if (n <= 20) {
+        unsigned long long ret = 1;
+        for (std::uint32_t i = 2; i <= n; ++i)
+            ret *= i;
+        return Bigint{ ret };
+    }
+    const Bigint half = factorial<Bigint>(n / 2, primes);
+    return half * half * prime_swing<Bigint>(n, primes);
+}
+
+} } // namespace details::bigint
+
+template<typename Limb, Limb Base, typename Allocator>
+basic_bigint<Limb, Base, Allocator> fac(basic_bigint<Limb, Base, Allocator> x)
+{
+    if (x.is_negative())
+        throw std::invalid_argument("zxshady::fac(bigint x) input cannot be negative.");
+
+    // the factorial of anything bigger would have tens of billions of digits
+    if ((std::numeric_limits<std::uint32_t>::max)() < x)
+        throw std::invalid_argument("zxshady::fac(bigint x) input is too big.");
+
+    const auto n = x.template to<std::uint32_t>();
+    return details::bigint::factorial<basic_bigint<Limb, Base, Allocator>>(n, details::bigint::primes_up_to(n));
+}
+
+namespace details { namespace bigint {
+
+// binomial(n, k) from its prime factorization, by kummer's theorem the exponent of p
+// is the number of carries when adding k and n - k in base p
+template<typename Bigint>
+Bigint binomial_kummer(std::uint32_t n, std::uint32_t k)
+{
+    factor_list<Bigint> factors;
+    for_each_prime(n, [&factors, n, k](std::uint32_t p) {
+        std::uint64_t power = 1; // at most n
+        for (std::uint32_t top = n, left = k, right = n - k; top != 0;) {
+            top /= p;
+            left /= p;
+            right /= p;
+            if (top != left + right)
+                power *= p;
+        }
+        if (power != 1)
+            factors.push(power);
+    });
+    return factors.product();
+}
+
+} } // namespace details::bigint
+
+template<typename Limb, Limb Base, typename Allocator>
+basic_bigint<Limb, Base, Allocator> falling_factorial(const basic_bigint<Limb, Base, Allocator>& x, unsigned long long k)
+{
+    using bigint = basic_bigint<Limb, Base, Allocator>;
+    if (k == 0)
+        return bigint{ 1 };
+
+    // x (x - 1) ... (x - k + 1) = (-1)^k (-x) (-x + 1) ... (-x + k - 1)
+    if (x.is_negative()) {
+        bigint ret = rising_factorial(abs(x), k);
+        ret.set_sign(k % 2 == 1);
+        return ret;
+    }
+
+    // one of the factors is 0
+    if (x < k)
+        return bigint{};
+
+    if (x <= (std::numeric_limits<unsigned long long>::max)()) {
+        const auto top = x.template to<unsigned long long>();
+        details::bigint::factor_list<bigint> factors;
+        for (unsigned long long i = 0; i < k; ++i)
+            factors.push(top - i);
+        return factors.product();
+    }
+
+    std::vector<bigint> terms;
+    terms.reserve(static_cast<std::size_t>(k));
+    terms.push_back(x);
+    for (unsigned long long i = 1; i < k; ++i)
+        terms.push_back(terms.back() - 1);
+    return details::bigint::product_tree<bigint>(terms, 0, terms.size());
+}
+
+template<typename Limb, Limb Base, typename Allocator>
+basic_bigint<Limb, Base, Allocator> rising_factorial(const basic_bigint<Limb, Base, Allocator>& x, unsigned long long k)
+{
+    using bigint = basic_bigint<Limb, Base, Allocator>;
+    if (k == 0)
+        return bigint{ 1 };
+    // x (x + 1) ... (x + k - 1), the factors run through 0 when -k < x <= 0
+    return falling_factorial(x + (k - 1), k);
+}
+
+template<typename Limb, Limb Base, typename Allocator>
+basic_bigint<Limb, Base, Allocator> binomial(const basic_bigint<Limb, Base, Allocator>& n, basic_bigint<Limb, Base, Allocator> k)
+{
+    using bigint = basic_bigint<Limb, Base, Allocator>;
+    if (k.is_negative())
+        return bigint{};
+
+    // binomial(n, k) = (-1)^k binomial(k - n - 1, k)
+    if (n.is_negative()) {
+        bigint ret = binomial(k - n - 1, k);
+        ret.set_sign(k.is_odd());
+        return ret;
+    }
+
+    if (n < k)
+        return bigint{};
+
+    // binomial(n, k) == binomial(n, n - k)
+    bigint other = n - k;
+    if (other < k)
+        k.swap(other);
+
+    if ((std::numeric_limits<std::uint32_t>::max)() < k)
+        throw std::invalid_argument("zxshady::binomial(const bigint& n, bigint k) min(k, n - k) is too big.");
+
+    // sieving up to n costs more than the k factors of n! / (n - k)! and the
+    // division by k! only when k is tiny next to n
+    const auto small = k.template to<std::uint32_t>();
+    if (n <= (std::numeric_limits<std::uint32_t>::max)() && k * 1024 >= n)
+        return details::bigint::binomial_kummer<bigint>(n.template to<std::uint32_t>(), small);
+    return falling_factorial(n, small) / fac(k);
+}
+
+namespace details { namespace bigint {
+
+inline bool is_prime_word(std::uint64_t n)
+{
+    if (n < 4)
+        return n >= 2;
+    if (n % 2 == 0)
+        return false;
+    for (std::uint64_t d = 3; d * d <= n; d += 2) {
+        if (n % d == 0)
+            return false;
+    }
+    return true;
+}
+
+} } // namespace details::bigint
+
+template<typename Limb, Limb Base, typename Allocator>
+bool basic_bigint<Limb, Base, Allocator>::is_perfect_square() const
+{
+    if (is_negative())
+        return false;
+
+    const auto is_square_mod = [](std::uint64_t residue, std::uint64_t modulus) {
+        for (std::uint64_t i = 0; i <= modulus / 2; ++i) {
+            if (i * i % modulus == residue)
+                return true;
+        }
+        return false;
+    };
+
+    // squares take 12 of the 64 classes mod 64, 16 of 63, 21 of 65 and 6 of 11
+    const std::uint64_t residue = mod_small(64 * 63 * 65 * 11);
+    if (!is_square_mod(residue % 64, 64) || !is_square_mod(residue % 63, 63) ||
+        !is_square_mod(residue % 65, 65) || !is_square_mod(residue % 11, 11))
+        return false;
+
+    return !sqrtrem(*this).second;
+}
+
+template<typename Limb, Limb Base, typename Allocator>
+bool basic_bigint<Limb, Base, Allocator>::is_perfect_power() const
+{
+    // 0, 1 and -1
+    if (mNumbers.size() == 1 && mNumbers[0] <= 1)
+        return true;
+
+    if (is_perfect_square())
+        return true;
+
+    // a^p == abs(*this) with a >= 2 and p an odd prime (every exponent has a prime factor,
+    // and only odd ones give negative numbers), so p < log2(abs(*this)) + 1
+    const bigint magnitude = abs(*this);
+    const unsigned long long bits = magnitude.bit_length();
+    const double digits = approximate_log10(magnitude);
+
+    // residues for checking a guessed a^p without building it
+    constexpr std::uint64_t kCheckPrimes[] = { 2147483647, 2147483629, 2147483587, 2147483579 };
+    std::uint64_t residues[details::bigint::size(kCheckPrimes)];
+    for (std::size_t i = 0; i < details::bigint::size(kCheckPrimes); ++i)
+        residues[i] = magnitude.mod_small(kCheckPrimes[i]);
+
+    for (const auto p : details::bigint::primes_up_to(static_cast<std::uint32_t>((std::min)(bits, 0xffffffffULL)))) {
+        if (p == 2)
+            continue;
+
+        // small roots come straight out of the logarithm to within a couple of units
+        const double estimate = std::pow(10.0, digits / p);
+        if (estimate < 4e9) {
+            const auto guess = static_cast<std::uint64_t>(estimate);
+            for (std::uint64_t a = guess > 4 ? guess - 2 : 2; a <= guess + 2; ++a) {
+                bool match = true;
+                for (std::size_t i = 0; i < details::bigint::size(kCheckPrimes) && match; ++i)
+                    match = details::bigint::pow_mod_word(a, p, kCheckPrimes[i]) == residues[i];
+                if (match && pow(bigint(a), p) == magnitude)
+                    return true;
+            }
+            continue;
+        }
+
+        // a p-th power is a p-th power residue mod every prime q = 2kp + 1,
+        // which misses with probability 1 - 1 / p for every q that is tried
+        bool possible = true;
+        int tried = 0;
+        for (std::uint64_t q = 2 * static_cast<std::uint64_t>(p) + 1; tried < 3 && q < 0xffffffffULL && possible; q += 2 * p) {
+            if (!details::bigint::is_prime_word(q))
+                continue;
+            ++tried;
+            const std::uint64_t residue = magnitude.mod_small(q);
+            possible = residue == 0 || details::bigint::pow_mod_word(residue, (q - 1) / p, q) == 1;
+        }
+        if (possible && pow(iroot(magnitude, p), p) == magnitude)
+            return true;
+    }
+    return false;
+}
+
+template<typename Limb, Limb Base, typename Allocator>
+basic_bigint<Limb, Base, Allocator> pow(basic_bigint<Limb, Base, Allocator> base, unsigned long long exponent)
+{
+    using bigint = basic_bigint<Limb, Base, Allocator>;
+    if (!base)
+        return base;
+
+    if (exponent == 0)
+        return bigint{ 1, base.get_allocator() };
+
+    const bool was_negative = exponent % 2 == 1 && base.is_negative();
+    base.set_positive();
+
+    // short cuts for bases whose powers are just shifts (this covers 1 and 10 too)
+    bigint ret{ base.get_allocator() };
+    if (base.is_pow_of_10()) {
+        const unsigned long long zeroes = base.digit_count() - 1;
+        if (zeroes == 0 || exponent <= (std::numeric_limits<unsigned long long>::max)() / zeroes)
+            ret = bigint::pow10(zeroes * exponent, base.get_allocator());
+        else
+            ret = bigint::pow_window(base, exponent);
+    }
+    else if (base.is_pow_of_2()) {
+        const unsigned long long bits = log2(base);
+        if (exponent <= (std::numeric_limits<unsigned long long>::max)() / bits)
+            ret = bigint(1, base.get_allocator()).mul_2exp(bits * exponent);
+        else
+            ret = bigint::pow_window(base, exponent);
+    }
+    else {
+        ret = bigint::pow_window(base, exponent);
+    }
+
+    ret.set_sign(was_negative);
+    return ret;
+}
+
+template<typename Limb, Limb Base, typename Allocator>
+basic_bigint<Limb, Base, Allocator> basic_bigint<Limb, Base, Allocator>::pow_window(const bigint& base, unsigned long long exponent)
+{
+    assert(exponent != 0);
+    int bits = 0;
+    while (bits < 64 && (exponent >> bits) != 0)
+        ++bits;
+
+    // table[i] = base^(2i + 1) for every odd window value
+    const int window = bits <= 8 ? 1 : bits <= 24 ? 2 : bits <= 48 ? 3 : 4;
+    // assignments keep the allocator of the target, so every entry starts out with the one of base
+    const auto alloc = base.get_allocator();
+    bigint table[1 << 3] = { bigint{ alloc }, bigint{ alloc }, bigint{ alloc }, bigint{ alloc },
+                             bigint{ alloc }, bigint{ alloc }, bigint{ alloc }, bigint{ alloc } };
+    table[0] = base;
+    if (window > 1) {
+        const bigint square = bigint::sqr(base);
+        for (int i = 1; i < (1 << (window - 1)); ++i)
+            table[i] = table[i - 1] * square;
+    }
+
+    // scan the exponent from the top bit, every window starts and ends with a set bit
+    bigint ret{ alloc };
+    bool empty = true;
+    for (int i = bits - 1; i >= 0;) {
+        if (((exponent >> i) & 1) == 0) {
+            ret = bigint::sqr(ret);
+            --i;
+            continue;
+        }
+
+        int low = (std::max)(i - window + 1, 0);
+        while (((exponent >> low) & 1) == 0)
+            ++low;
+        const auto value = static_cast<std::size_t>((exponent >> low) & ((1ULL << (i - low + 1)) - 1));
+
+        if (empty) {
+            ret = table[value / 2];
+            empty = false;
+        }
+        else {
+            for (int j = low; j <= i; ++j)
+                ret = bigint::sqr(ret);
+            ret *= table[value / 2];
+        }
+        i = low - 1;
+    }
+    return ret;
+}
+
+namespace details { namespace bigint {
+
+// base 2^32 conversions split the number in halves by 2^(32 * kBinaryBlockWords * 2^level) and
+// work on the halves, O(M(n) log n) instead of the O(n^2) of peeling one word at a time
+constexpr std::size_t kBinaryBlockWords = 32;
+
+// powers[level] = 2^(32 * kBinaryBlockWords * 2^level) splits a number of kBinaryBlockWords * 2^(level + 1)
+// words in halves, for every level needed by `words` words (level 0 converts directly and never splits)
+template<typename Bigint>
+std::vector<Bigint> binary_split_powers(std::size_t words, const typename Bigint::allocator_type& alloc)
+{
+    std::vector<Bigint> powers;
+    powers.push_back(Bigint(1, alloc).mul_2exp(32 * kBinaryBlockWords));
+    for (std::size_t span = 2 * kBinaryBlockWords; span < words; span *= 2)
+        powers.push_back(powers.back() * powers.back());
+    return powers;
+}
+
+// writes x (below 2^(32 * kBinaryBlockWords * 2^(level + 1))) into out[0, kBinaryBlockWords * 2^(level + 1))
+template<typename Bigint>
+void binary_words(Bigint x, std::size_t level, const std::vector<Bigint>& powers, std::uint32_t* out)
+{
+    if (level == 0) {
+        for (std::size_t i = 0; x && i < 2 * kBinaryBlockWords; ++i) {
+            out[i] = static_cast<std::uint32_t>(x.mod_small(std::uint64_t{ 1 } << 32));
+            x.div_2exp(32);
+        }
+        return;
+    }
+
+    Bigint high{ x.get_allocator() };
+    Bigint low{ x.get_allocator() };
+    Bigint::divmod(x, powers[level], high, low);
+    const std::size_t half = kBinaryBlockWords << level;
+    if (low)
+        binary_words(std::move(low), level - 1, powers, out);
+    if (high)
+        binary_words(std::move(high), level - 1, powers, out + half);
+}
+
+// abs(x) in base 2^32, least significant word first
+template<typename Bigint>
+std::vector<std::uint32_t> binary_words(Bigint x)
+{
+    x.set_positive();
+    std::vector<std::uint32_t> words;
+    if (!x)
+        return words;
+
+    const std::size_t count = (x.bit_length() + 31) / 32;
+    const std::vector<Bigint> powers = binary_split_powers<Bigint>(count, x.get_allocator());
+    words.resize(kBinaryBlockWords << powers.size());
+    binary_words(std::move(x), powers.size() - 1, powers, words.data());
+    words.resize(count);
+    return words;
+}
+
+// the value of words[0, kBinaryBlockWords * 2^(level + 1)), zeros past the end of `words`
+template<typename Bigint>
+Bigint from_binary_words(const std::vector<std::uint32_t>& words, std::size_t first, std::size_t level, const std::vector<Bigint>& powers)
+{
+    if (first >= words.size())
+        return Bigint{ powers[0].get_allocator() };
+
+    if (level == 0) {
+        Bigint ret{ powers[0].get_allocator() };
+        const std::size_t last = (std::min)(words.size(), first + 2 * kBinaryBlockWords);
+        for (std::size_t i = last; i-- > first;) {
+            ret.mul_2exp(32);
+            ret += words[i];
+        }
+        return ret;
+    }
+
+    const std::size_t half = kBinaryBlockWords << level;
+    Bigint ret = from_binary_words(words, first + half, level - 1, powers);
+    if (ret)
+        ret *= powers[level];
+    return ret += from_binary_words(words, first, level - 1, powers);
+}
+
+// inverse of binary_words, the result is not negative and allocated by alloc
+template<typename Bigint>
+Bigint from_binary_words(const std::vector<std::uint32_t>& words, const typename Bigint::allocator_type& alloc)
+{
+    if (words.empty())
+        return Bigint{ alloc };
+    const std::vector<Bigint> powers = binary_split_powers<Bigint>(words.size(), alloc);
+    return from_binary_words(words, 0, powers.size() - 1, powers);
+}
+
+} } // namespace details::bigint
+
+template<typename Limb, Limb Base, typename Allocator>
+std::vector<std::uint32_t> basic_bigint<Limb, Base, Allocator>::to_words() const
+{
+    return details::bigint::binary_words(*this);
+}
+
+template<typename Limb, Limb Base, typename Allocator>
+basic_bigint<Limb, Base, Allocator> basic_bigint<Limb, Base, Allocator>::from_words(const std::vector<std::uint32_t>& words)
+{
+    return details::bigint::from_binary_words<bigint>(words, allocator_type());
+}
+
+namespace details { namespace bigint {
+
+// a op b on the two's complement of both, a negative x is ~(abs(x) - 1) followed by infinitely many ones
+template<typename Bigint, typename Op>
+Bigint bitwise(const Bigint& a, const Bigint& b, Op op)
+{
+    const auto twos_complement = [](const Bigint& x) {
+        if (!x.is_negative())
+            return binary_words(x);
+        auto words = binary_words(abs(x) - 1);
+        for (auto& word : words)
+            word = ~word;
+        return words;
+    };
+    std::vector<std::uint32_t> a_words = twos_complement(a);
+    std::vector<std::uint32_t> b_words = twos_complement(b);
+    const std::uint32_t a_fill = a.is_negative() ? ~std::uint32_t{ 0 } : 0;
+    const std::uint32_t b_fill = b.is_negative() ? ~std::uint32_t{ 0 } : 0;
+
+    // a result with leading ones is negative, -(~result + 1)
+    const std::uint32_t fill = op(a_fill, b_fill);
+    const std::size_t size = (std::max)(a_words.size(), b_words.size());
+    a_words.resize(size, a_fill);
+    b_words.resize(size, b_fill);
+    for (std::size_t i = 0; i < size; ++i)
+        a_words[i] = op(a_words[i], b_words[i]) ^ fill;
+    while (!a_words.empty() && a_words.back() == 0)
+        a_words.pop_back();
+
+    Bigint ret = from_binary_words<Bigint>(a_words, a.get_allocator());
+    if (fill != 0) {
+        ++ret;
+        ret.flip_sign();
+    }
+    return ret;
+}
+
+} } // namespace details::bigint
+
+template<typename Limb, Limb Base, typename Allocator>
+basic_bigint<Limb, Base, Allocator>& basic_bigint<Limb, Base, Allocator>::operator&=(const bigint& rhs) &
+{
+    return *this = details::bigint::bitwise(*this, rhs, [](std::uint32_t a, std::uint32_t b) -> std::uint32_t { return a & b; });
+}
+
+template<typename Limb, Limb Base, typename Allocator>
+basic_bigint<Limb, Base, Allocator>& basic_bigint<Limb, Base, Allocator>::operator|=(const bigint& rhs) &
+{
+    return *this = details::bigint::bitwise(*this, rhs, [](std::uint32_t a, std::uint32_t b) -> std::uint32_t { return a | b; });
+}
+
+template<typename Limb, Limb Base, typename Allocator>
+basic_bigint<Limb, Base, Allocator>& basic_bigint<Limb, Base, Allocator>::operator^=(const bigint& rhs) &
+{
+    return *this = details::bigint::bitwise(*this, rhs, [](std::uint32_t a, std::uint32_t b) -> std::uint32_t { return a ^ b; });
+}
+
+template<typename Limb, Limb Base, typename Allocator>
+std::uint64_t basic_bigint<Limb, Base, Allocator>::low_bits(std::size_t first) const noexcept
+{
+    std::uint64_t ret = 0;
+    std::uint64_t power = 1;
+    // B^i is a multiple of 2^(i * kDigitCountOfMax), the limbs past 64 bits drop out
+    const std::size_t count = (64 + kDigitCountOfMax - 1) / kDigitCountOfMax;
+    const std::size_t last = (std::min)(mNumbers.size(), first + count);
+    for (std::size_t i = first; i < last; ++i) {
+        ret += mNumbers[i] * power; // wraps around mod 2^64 on purpose
+        power *= kMaxDigitsInNumber;
+    }
+    return ret;
+}
+
+// *this == 2^64 * high + low with low the two's complement low bits, rhs only touches low
+template<typename Limb, Limb Base, typename Allocator>
+void basic_bigint<Limb, Base, Allocator>::and_word(std::uint64_t rhs, bool rhs_negative)
+{
+    const std::uint64_t low = is_negative() ? 0 - low_bits() : low_bits();
+    if (!rhs_negative) {
+        *this = low & rhs;
+        return;
+    }
+    *this -= low;
+    *this += low & rhs;
+}
+
+template<typename Limb, Limb Base, typename Allocator>
+void basic_bigint<Limb, Base, Allocator>::or_word(std::uint64_t rhs, bool rhs_negative)
+{
+    const std::uint64_t low = is_negative() ? 0 - low_bits() : low_bits();
+    if (rhs_negative) {
+        *this = static_cast<std::int64_t>(low | rhs);
+        return;
+    }
+    *this -= low;
+    *this += low | rhs;
+}
+
+template<typename Limb, Limb Base, typename Allocator>
+void basic_bigint<Limb, Base, Allocator>::xor_word(std::uint64_t rhs, bool rhs_negative)
+{
+    const std::uint64_t low = is_negative() ? 0 - low_bits() : low_bits();
+    *this -= low;
+    if (rhs_negative) {
+        // high turns into ~high == -high - 1
+        flip_sign();
+        *this -= (std::numeric_limits<std::uint64_t>::max)();
+        --*this;
+    }
+    *this += low ^ rhs;
+}
+
+template<typename Limb, Limb Base, typename Allocator>
+basic_bigint<Limb, Base, Allocator>& basic_bigint<Limb, Base, Allocator>::operator>>=(unsigned long long bits) &
+{
+    if (!is_negative())
+        return div_2exp(bits);
+
+    // floor(-x / 2^k) == -((x - 1) / 2^k) - 1 for x > 0
+    set_positive();
+    --*this;
+    div_2exp(bits);
+    ++*this;
+    set_negative();
+    return *this;
+}
+
+template<typename Limb, Limb Base, typename Allocator>
+bool basic_bigint<Limb, Base, Allocator>::test_bit(std::size_t index) const
+{
+    // bit i of -x is the inverse of bit i of x - 1
+    if (index < 64) {
+        const std::uint64_t low = is_negative() ? 0 - low_bits() : low_bits();
+        return (low >> index) & 1;
+    }
+
+    // x mod 2^(index + 1) only depends on the limbs below B^limbs
+    const std::size_t limbs = index / kDigitCountOfMax + 1;
+    bigint low = limb_slice(*this, 0, limbs);
+    if (is_negative()) {
+        if (!low)
+            low = bigint::pow10(limbs * kDigitCountOfMax, get_allocator());
+        --low;
+    }
+    low.div_2exp(index);
+    return low.is_odd() != is_negative();
+}
+
+template<typename Limb, Limb Base, typename Allocator>
+basic_bigint<Limb, Base, Allocator>& basic_bigint<Limb, Base, Allocator>::set_bit(std::size_t index, bool value) &
+{
+    if (test_bit(index) == value)
+        return *this;
+    if (value)
+        *this += bigint(1).mul_2exp(index);
+    else
+        *this -= bigint(1).mul_2exp(index);
+    return *this;
+}
+
+template<typename Limb, Limb Base, typename Allocator>
+std::size_t basic_bigint<Limb, Base, Allocator>::popcount() const
+{
+    if (is_negative())
+        return (std::numeric_limits<std::size_t>::max)();
+
+    std::size_t ret = 0;
+    for (auto word : details::bigint::binary_words(*this)) {
+        for (; word != 0; word &= word - 1)
+            ++ret;
+    }
+    return ret;
+}
+
+template<typename Limb, Limb Base, typename Allocator>
+std::size_t basic_bigint<Limb, Base, Allocator>::count_trailing_zeros() const
+{
+    if (!*this)
+        return (std::numeric_limits<std::size_t>::max)();
+
+    // every zero limb is a factor of B, so of 2^kDigitCountOfMax
+    std::size_t first = 0;
+    while (mNumbers[first] == 0)
+        ++first;
+
+    std::uint64_t low = low_bits(first);
+    if (low == 0) {
+        // 2^64 divides what is left, only for multiples of big powers of 2
+        bigint rest = limb_slice(*this, first, mNumbers.size());
+        rest.div_2exp(64);
+        return first * kDigitCountOfMax + 64 + rest.count_trailing_zeros();
+    }
+
+    std::size_t ret = first * kDigitCountOfMax;
+    for (; low % 2 == 0; low /= 2)
+        ++ret;
+    return ret;
+}
+
+namespace details { namespace bigint {
+
+// left to right sliding window exponentiation where every product goes through multiply,
+// the exponent is given by binary_words and must not be 0
+template<typename Bigint, typename Multiply>
+Bigint window_exponentiate(const Bigint& base, const std::vector<std::uint32_t>& exponent, Multiply multiply)
+{
+    assert(!exponent.empty() && exponent.back() != 0);
+    std::size_t bits = (exponent.size() - 1) * 32;
+    for (auto top = exponent.back(); top != 0; top >>= 1)
+        ++bits;
+    const auto bit = [&exponent](std::size_t i) -> unsigned { return (exponent[i / 32] >> (i % 32)) & 1; };
+
+    // a window of w bits costs 2^(w - 1) table entries and saves a multiplication every w bits
+    constexpr std::size_t kWindowLimits[] = { 7, 25, 81, 241, 673, 1793, 4609 };
+    std::size_t window = 1;
+    while (window <= size(kWindowLimits) && bits > kWindowLimits[window - 1])
+        ++window;
+
+    // table[i] = base^(2i + 1), the entries and ret keep the allocator of base
+    std::vector<Bigint> table(std::size_t{ 1 } << (window - 1), Bigint{ base.get_allocator() });
+    table[0] = base;
+    if (window > 1) {
+        const Bigint square = multiply(base, base);
+        for (std::size_t i = 1; i < table.size(); ++i)
+            table[i] = multiply(table[i - 1], square);
+    }
+
+    Bigint ret{ base.get_allocator() };
+    bool empty = true;
+    for (std::size_t i = bits; i-- > 0;) {
+        if (bit(i) == 0) {
+            ret = multiply(ret, ret);
+            continue;
+        }
+
+        std::size_t low = i + 1 >= window ? i + 1 - window : 0;
+        while (bit(low) == 0)
+            ++low;
+        std::size_t value = 0;
+        for (std::size_t j = i + 1; j-- > low;)
+            value = value * 2 + bit(j);
+
+        if (empty) {
+            ret = table[value / 2];
+            empty = false;
+        }
+        else {
+            for (std::size_t j = low; j <= i; ++j)
+                ret = multiply(ret, ret);
+            ret = multiply(ret, table[value / 2]);
+        }
+        i = low;
+    }
+    return ret;
+}
+
+} } // namespace details::bigint
+
+template<typename Limb, Limb Base, typename Allocator>
+basic_bigint<Limb, Base, Allocator> powmod(const basic_bigint<Limb, Base, Allocator>& base, const basic_bigint<Limb, Base, Allocator>& exponent, const basic_bigint<Limb, Base, Allocator>& modulus)
+{
+    using bigint = basic_bigint<Limb, Base, Allocator>;
+    if (modulus <= static_cast<unsigned char>(0))
+        throw std::invalid_argument("zxshady::powmod(const bigint& base, const bigint& exponent, const bigint& modulus) modulus must be positive");
+
+    if (exponent.is_negative())
+        throw std::invalid_argument("zxshady::powmod(const bigint& base, const bigint& exponent, const bigint& modulus) exponent cannot be negative");
+
+    if (modulus.mod_small(10) % 2 != 0 && modulus.mod_small(10) != 5)
+        return powmod(base, exponent, typename bigint::montgomery_context(modulus));
+
+    if (!exponent)
+        return modulus == static_cast<unsigned char>(1) ? bigint{ base.get_allocator() } : bigint{ 1, base.get_allocator() };
+
+    // moduli sharing a factor with the limb base have no montgomery form, use barrett reduction
+    const typename bigint::barrett_reducer reducer(modulus);
+    typename bigint::barrett_reducer::scratch buffers{ modulus.get_allocator() };
+    const auto multiply = [&](const bigint& a, const bigint& b) -> bigint {
+        bigint product = a * b;
+        reducer.reduce(product, buffers);
+        return product;
+    };
+    bigint reduced = base % modulus;
+    if (reduced.is_negative())
+        reduced += modulus;
+    return details::bigint::window_exponentiate(reduced, details::bigint::binary_words(exponent), multiply);
+}
+
+template<typename Limb, Limb Base, typename Allocator>
+basic_bigint<Limb, Base, Allocator> powmod(const basic_bigint<Limb, Base, Allocator>& base, const basic_bigint<Limb, Base, Allocator>& exponent, const typename basic_bigint<Limb, Base, Allocator>::montgomery_context& context)
+{
+    using bigint = basic_bigint<Limb, Base, Allocator>;
+    if (exponent.is_negative())
+        throw std::invalid_argument("zxshady::powmod(const bigint& base, const bigint& exponent, const bigint::montgomery_context& context) exponent cannot be negative");
+
+    if (!exponent)
+        return context.modulus() == static_cast<unsigned char>(1) ? bigint{ base.get_allocator() } : bigint{ 1, base.get_allocator() };
+
+    const auto multiply = [&context](const bigint& a, const bigint& b) { return context.multiply(a, b); };
+    return context.from_montgomery(details::bigint::window_exponentiate(context.to_montgomery(base), details::bigint::binary_words(exponent), multiply));
+}
+
+template<typename Limb, Limb Base, typename Allocator>
+basic_bigint<Limb, Base, Allocator>::montgomery_context::montgomery_context(const bigint& modulus)
+    : mModulus(modulus)
+    , mOne(modulus.get_allocator())
+    , mRSquared(modulus.get_allocator())
+    , mInverse(modulus.get_allocator())
+{
+    if (modulus <= static_cast<unsigned char>(0))
+        throw std::invalid_argument("zxshady::bigint::montgomery_context(const bigint& modulus) modulus must be positive");
+
+    const DoubleWidthType low = modulus.mNumbers[0];
+    if (low % 2 == 0 || low % 5 == 0)
+        throw std::invalid_argument("zxshady::bigint::montgomery_context(const bigint& modulus) modulus must be coprime to 10");
+
+    // modulus^-1 mod 10 then newton steps x * (2 - modulus * x), each doubles the correct digits
+    DoubleWidthType inverse = low % 10 == 1 ? 1 : low % 10 == 3 ? 7 : low % 10 == 7 ? 3 : 9;
+    for (std::size_t digits = 1; digits < kDigitCountOfMax; digits *= 2)
+        inverse = inverse * (2 + kMaxDigitsInNumber - low * inverse % kMaxDigitsInNumber) % kMaxDigitsInNumber;
+    mLimbInverse = static_cast<number_type>(kMaxDigitsInNumber - inverse);
+
+    const std::size_t n = modulus.mNumbers.size();
+    mOne = bigint::pow10(n * kDigitCountOfMax, modulus.get_allocator()) % modulus;
+    mRSquared = bigint::pow10(2 * n * kDigitCountOfMax, modulus.get_allocator()) % modulus;
+
+    if (n >= kRedcThreshold) {
+        // same newton steps on whole limbs, lifting modulus^-1 mod B^k up to k = n
+        bigint full_inverse{ static_cast<number_type>(inverse), modulus.get_allocator() };
+        for (std::size_t k = 1; k < n;) {
+            k = (std::min)(2 * k, n);
+            const bigint product = limb_slice(limb_slice(modulus, 0, k) * full_inverse, 0, k);
+            const bigint correction = limb_slice(bigint::pow10(k * kDigitCountOfMax, modulus.get_allocator()) + static_cast<unsigned char>(2) - product, 0, k);
+            full_inverse = limb_slice(full_inverse * correction, 0, k);
+        }
+        mInverse = bigint::pow10(n * kDigitCountOfMax, modulus.get_allocator()) - full_inverse;
+    }
+}
+
+template<typename Limb, Limb Base, typename Allocator>
+basic_bigint<Limb, Base, Allocator> basic_bigint<Limb, Base, Allocator>::montgomery_context::to_montgomery(const bigint& x) const
+{
+    bigint reduced = x % mModulus;
+    if (reduced.is_negative())
+        reduced += mModulus;
+    return multiply(reduced, mRSquared);
+}
+
+template<typename Limb, Limb Base, typename Allocator>
+basic_bigint<Limb, Base, Allocator> basic_bigint<Limb, Base, Allocator>::montgomery_context::from_montgomery(bigint x) const
+{
+    reduce(x);
+    return x;
+}
+
+template<typename Limb, Limb Base, typename Allocator>
+basic_bigint<Limb, Base, Allocator> basic_bigint<Limb, Base, Allocator>::montgomery_context::multiply(const bigint& a, const bigint& b) const
+{
+    bigint ret = a * b;
+    reduce(ret);
+    return ret;
+}
+
+template<typename Limb, Limb Base, typename Allocator>
+void basic_bigint<Limb, Base, Allocator>::montgomery_context::reduce(bigint& x) const
+{
+    const std::size_t n = mModulus.mNumbers.size();
+    if (n < kRedcThreshold) {
+        // add multiples of modulus * B^i clearing the limbs from the bottom up, then drop them
+        const number_type* m = mModulus.mNumbers.data();
+        x.mNumbers.resize(2 * n + 1);
+        number_type* t = &x.mNumbers[0];
+        for (std::size_t i = 0; i < n; ++i) {
+            number_type u;
+            div_base(static_cast<DoubleWidthType>(t[i]) * mLimbInverse, u);
+            DoubleWidthType carry = 0;
+            for (std::size_t j = 0; j < n; ++j) {
+                const DoubleWidthType current = t[i + j] + static_cast<DoubleWidthType>(u) * m[j] + carry;
+                carry = div_base(current, t[i + j]);
+            }
+            for (std::size_t j = i + n; carry != 0; ++j) {
+                const DoubleWidthType current = t[j] + carry;
+                carry = div_base(current, t[j]);
+            }
+        }
+        x.mNumbers.erase(0, n);
+        x.fix();
+    }
+    else {
+        // q = (x mod R) * -modulus^-1 mod R makes x + q * modulus a multiple of R
+        const bigint q = limb_slice(limb_slice(x, 0, n) * mInverse, 0, n);
+        x += q * mModulus;
+        x = limb_slice(x, n, x.mNumbers.size());
+    }
+
+    // x < 2 * modulus here
+    if (!bigint::lt(x, mModulus, false, false))
+        x -= mModulus;
+}
+
+template<typename Limb, Limb Base, typename Allocator>
+basic_bigint<Limb, Base, Allocator>::barrett_reducer::barrett_reducer(const bigint& modulus)
+    : mModulus(abs(modulus))
+    , mReciprocal(modulus.get_allocator())
+{
+    if (!modulus)
+        throw std::invalid_argument("zxshady::bigint::barrett_reducer(const bigint& modulus) Division by zero.");
+
+    mReciprocal = bigint::pow10(2 * mModulus.mNumbers.size() * kDigitCountOfMax, mModulus.get_allocator()) / mModulus;
+}
+
+template<typename Limb, Limb Base, typename Allocator>
+void basic_bigint<Limb, Base, Allocator>::barrett_reducer::reduce(bigint& x) const
+{
+    scratch buffers{ x.get_allocator() };
+    reduce(x, buffers);
+}
+
+template<typename Limb, Limb Base, typename Allocator>
+void basic_bigint<Limb, Base, Allocator>::barrett_reducer::reduce(bigint& x, scratch& buffers) const
+{
+    if (bigint::lt(x, mModulus, false, false))
+        return;
+
+    const std::size_t n = mModulus.mNumbers.size();
+    number_type* limbs = &x.mNumbers[0];
+    std::size_t size = x.mNumbers.size();
+
+    // x = high * B^offset + low with high < B^(2n), replacing high by high % modulus
+    // keeps x % modulus and takes n limbs off the top
+    while (size > 2 * n) {
+        const std::size_t offset = size - 2 * n;
+        reduce_limbs(limbs + offset, 2 * n, buffers);
+        size = offset + n;
+    }
+    reduce_limbs(limbs, size, buffers);
+    x.fix();
+}
+
+template<typename Limb, Limb Base, typename Allocator>
+void basic_bigint<Limb, Base, Allocator>::barrett_reducer::reduce_limbs(number_type* x, std::size_t size, scratch& buffers) const
+{
+    const std::size_t n = mModulus.mNumbers.size();
+    const number_type* m = mModulus.mNumbers.data();
+    assert(size <= 2 * n);
+    if (size < n)
+        return;
+
+    // q = (x / B^(n - 1)) * reciprocal / B^(n + 1) is x / modulus or at most a few less,
+    // below the karatsuba threshold only the limbs of the products that matter are computed
+    const bool truncate = n < kKaratsubaThreshold;
+    const std::size_t reciprocal_size = mReciprocal.mNumbers.size();
+    auto& quotient = buffers.mQuotient;
+    quotient.assign(size - (n - 1) + reciprocal_size + 1, 0);
+    if (truncate)
+        mul_high_limbs(x + (n - 1), size - (n - 1), mReciprocal.mNumbers.data(), reciprocal_size, &quotient[0], n - 1);
+    else
+        mul_limbs(x + (n - 1), size - (n - 1), mReciprocal.mNumbers.data(), reciprocal_size, &quotient[0], quotient.get_allocator());
+
+    std::size_t qsize = quotient.size();
+    while (qsize > n + 1 && quotient[qsize - 1] == 0)
+        --qsize;
+
+    // x - q * modulus < B^(n + 1), so it is enough to work modulo B^(n + 1)
+    const std::size_t width = (std::min)(size, n + 1);
+    if (qsize > n + 1) {
+        qsize -= n + 1;
+        auto& product = buffers.mProduct;
+        product.assign((std::max)(qsize + n + 1, width), 0);
+        if (truncate)
+            mul_low_limbs(quotient.data() + (n + 1), qsize, m, n, &product[0], width);
+        else
+            mul_limbs(quotient.data() + (n + 1), qsize, m, n, &product[0], product.get_allocator());
+
+        bool borrow = false;
+        for (std::size_t i = 0; i < width; ++i) {
+            const DoubleWidthType sub = static_cast<DoubleWidthType>(product[i]) + borrow;
+            borrow = x[i] < sub;
+            x[i] = static_cast<number_type>(borrow ? x[i] + kMaxDigitsInNumber - sub : x[i] - sub);
+        }
+        std::fill(x + width, x + size, 0);
+    }
+
+    while (!lt_limbs(x, width, m, n))
+        sub_limbs(x, width, m, n);
+}
+
+template<typename Limb, Limb Base, typename Allocator>
+basic_bigint<Limb, Base, Allocator> basic_bigint<Limb, Base, Allocator>::reciprocal(std::size_t precision) const
+{
+    if (!*this)
+        throw std::invalid_argument("zxshady::bigint::reciprocal(std::size_t precision) Division by zero.");
+
+    // 10^precision < *this
+    if (precision + 1 < digit_count())
+        return bigint{ get_allocator() };
+
+    // B^k / *this exactly, then drop the extra decimal digits
+    const std::size_t k = (std::max)((precision + kDigitCountOfMax - 1) / kDigitCountOfMax, mNumbers.size());
+    const bigint d = abs(*this);
+    bigint x = reciprocal_limbs(d, k);
+    bigint r{ noinit_t{}, get_allocator() };
+    r.mNumbers.assign(k + 1, 0);
+    r.mNumbers[k] = 1;
+    r -= d * x;
+    while (r.is_negative()) {
+        r += d;
+        --x;
+    }
+    while (!bigint::lt(r, d, false, false)) {
+        r -= d;
+        ++x;
+    }
+
+    x = div_pow10(x, k * kDigitCountOfMax - precision);
+    x.set_sign(is_negative());
+    return x;
+}
+
+template<typename Limb, Limb Base, typename Allocator>
+basic_bigint<Limb, Base, Allocator> basic_bigint<Limb, Base, Allocator>::div_by_reciprocal(const bigint& a, const bigint& b, const bigint& reciprocal, std::size_t precision)
+{
+    if (!b)
+        throw std::invalid_argument("zxshady::bigint::div_by_reciprocal Division by zero.");
+
+    if (precision < a.digit_count())
+        return a / b;
+
+    // reciprocal is 10^precision / b rounded down so a * reciprocal / 10^precision
+    // is the quotient or one less
+    const bigint divisor = abs(b);
+    bigint q = div_pow10(abs(a) * abs(reciprocal), precision);
+    bigint r = abs(a) - q * divisor;
+    while (r.is_negative()) {
+        r += divisor;
+        --q;
+    }
+    while (!bigint::lt(r, divisor, false, false)) {
+        r -= divisor;
+        ++q;
+    }
+    q.set_sign(a.is_negative() != b.is_negative());
+    return q;
+}
+
+template<typename Limb, Limb Base, typename Allocator>
+basic_bigint<Limb, Base, Allocator> basic_bigint<Limb, Base, Allocator>::pow10(unsigned long long exponent, const allocator_type& alloc)
+{
+    if (exponent == 0)
+        return bigint{ 1, alloc };
+    bigint ret{ alloc };
+    ret.mNumbers.resize(exponent / kDigitCountOfMax + 1);
+    ret.mNumbers[exponent / kDigitCountOfMax] = static_cast<number_type>(math::pow10(exponent % kDigitCountOfMax));
+    return ret;
+}
+namespace details { namespace bigint {
+
+// (a / n) for odd n
+inline int jacobi_word(std::uint64_t a, std::uint64_t n)
+{
+    int ret = 1;
+    a %= n;
+    while (a != 0) {
+        while (a % 2 == 0) {
+            a /= 2;
+            if (n % 8 == 3 || n % 8 == 5)
+                ret = -ret;
+        }
+        std::swap(a, n);
+        if (a % 4 == 3 && n % 4 == 3)
+            ret = -ret;
+        a %= n;
+    }
+    return n == 1 ? ret : 0;
+}
+
+struct small_prime_group {
+    std::uint64_t product;
+    std::size_t first;
+    std::size_t last;
+};
+
+} } // namespace details::bigint
+
+template<typename Limb, Limb Base, typename Allocator>
+int basic_bigint<Limb, Base, Allocator>::small_prime_test() const
+{
+    if (is_negative() || (mNumbers.size() == 1 && mNumbers[0] < 2))
+        return 0;
+
+    // the primes below 2^16 packed into products that mod_small takes in one pass
+    static const std::vector<std::uint32_t> primes = details::bigint::primes_up_to(65535);
+    static const std::vector<details::bigint::small_prime_group> groups = [] {
+        std::vector<details::bigint::small_prime_group> ret;
+        for (std::size_t i = 0; i < primes.size(); i = ret.back().last) {
+            details::bigint::small_prime_group group{ 1, i, i };
+            while (group.last < primes.size() && static_cast<DoubleWidthType>(group.product) * primes[group.last] <= kMaxSmallPrimeProduct)
+                group.product *= primes[group.last++];
+            ret.push_back(group);
+        }
+        return ret;
+    }();
+
+    // the sieve pays for itself while it is cheaper than the miller-rabin rounds it saves,
+    // those grow with the cube of the size and one pass of mod_small only linearly
+    const std::size_t count = (std::min)(groups.size(), 24 * mNumbers.size());
+    for (std::size_t g = 0; g < count; ++g) {
+        const std::uint64_t residue = mod_small(groups[g].product);
+        for (std::size_t i = groups[g].first; i < groups[g].last; ++i) {
+            if (residue % primes[i] == 0)
+                return *this == primes[i] ? 1 : 0;
+        }
+    }
+
+    const std::uint64_t largest = primes[groups[count - 1].last - 1];
+    if (*this < largest * largest)
+        return 1;
+    if (mNumbers.size() > 3 || *this > (std::numeric_limits<std::uint64_t>::max)())
+        return -1;
+
+    // these bases leave no strong pseudoprime below 2^64 (jim sinclair)
+    const montgomery_context context(*this);
+    bigint d = *this - static_cast<unsigned char>(1);
+    const std::size_t s = remove_twos(d);
+    for (std::uint64_t base : { 2, 325, 9375, 28178, 450775, 9780504, 1795265022 }) {
+        const bigint reduced = base % to<std::uint64_t>();
+        if (reduced && !is_strong_probable_prime(context, reduced, d, s))
+            return 0;
+    }
+    return 1;
+}
+
+template<typename Limb, Limb Base, typename Allocator>
+std::size_t basic_bigint<Limb, Base, Allocator>::remove_twos(bigint& x)
+{
+    std::size_t ret = 0;
+    for (; x.mNumbers[0] % 2 == 0 && x; ++ret)
+        x.half();
+    return ret;
+}
+
+template<typename Limb, Limb Base, typename Allocator>
+bool basic_bigint<Limb, Base, Allocator>::is_strong_probable_prime(const montgomery_context& context, const bigint& base, const bigint& d, std::size_t s)
+{
+    const auto multiply = [&context](const bigint& a, const bigint& b) { return context.multiply(a, b); };
+    const bigint minus_one = context.modulus() - context.one();
+    bigint x = details::bigint::window_exponentiate(context.to_montgomery(base), details::bigint::binary_words(d), multiply);
+    if (x == context.one() || x == minus_one)
+        return true;
+
+    for (std::size_t i = 1; i < s; ++i) {
+        x = context.multiply(x, x);
+        if (x == minus_one)
+            return true;
+        if (x == context.one())
+            return false;
+    }
+    return false;
+}
+
+template<typename Limb, Limb Base, typename Allocator>
+bool basic_bigint<Limb, Base, Allocator>::is_strong_lucas_probable_prime(const montgomery_context& context)
+{
+    const bigint& n = context.modulus();
+
+    // selfridge: the first D in 5, -7, 9, -11, ... with (D / n) == -1, P = 1 and Q = (1 - D) / 4
+    std::int64_t D = 5;
+    for (;;) {
+        const auto magnitude = static_cast<std::uint64_t>(D < 0 ? -D : D);
+        // reciprocity turns (D / n) into (n mod |D| / |D|), (-1 / n) is -1 for n == 3 mod 4
+        int symbol = details::bigint::jacobi_word(n.mod_small(magnitude), magnitude);
+        if ((magnitude % 4 == 3 && n.mNumbers[0] % 4 == 3) != (D < 0 && n.mNumbers[0] % 4 == 3))
+            symbol = -symbol;
+        if (symbol == -1)
+            break;
+        if (symbol == 0)
+            return false; // n is past trial division so it is bigger than |D|
+
+        D = D < 0 ? 2 - D : -D - 2;
+        // a square never gets (D / n) == -1
+        if (D == 13 && n.is_perfect_square())
+            return false;
+    }
+
+    const auto add = [&n](bigint a, const bigint& b) {
+        a += b;
+        if (a >= n)
+            a -= n;
+        return a;
+    };
+    const auto sub = [&n](bigint a, const bigint& b) {
+        a -= b;
+        if (a.is_negative())
+            a += n;
+        return a;
+    };
+    // halving is linear so it works on the montgomery forms as well
+    const auto half = [&n](bigint a) {
+        if (a.is_odd())
+            a += n;
+        a.half();
+        return a;
+    };
+
+    const bigint d_form = context.to_montgomery(D);
+    const bigint q_form = context.to_montgomery((1 - D) / 4);
+    bigint d = n + static_cast<unsigned char>(1);
+    const std::size_t s = remove_twos(d);
+    const auto words = details::bigint::binary_words(d);
+
+    // U_1 = 1, V_1 = P, then U_2k = U_k V_k, V_2k = V_k^2 - 2 Q^k,
+    // U_k+1 = (P U_k + V_k) / 2 and V_k+1 = (D U_k + P V_k) / 2
+    bigint u = context.one();
+    bigint v = context.one();
+    bigint q_power = q_form;
+    std::size_t bit = words.size() * 32 - 1;
+    while ((words.back() >> (bit % 32)) == 0)
+        --bit;
+    while (bit-- > 0) {
+        u = context.multiply(u, v);
+        v = sub(context.multiply(v, v), add(q_power, q_power));
+        q_power = context.multiply(q_power, q_power);
+        if ((words[bit / 32] >> (bit % 32)) & 1) {
+            bigint next_u = half(add(u, v));
+            v = half(add(context.multiply(d_form, u), v));
+            u.swap(next_u);
+            q_power = context.multiply(q_power, q_form);
+        }
+    }
+
+    if (!u || !v)
+        return true;
+    for (std::size_t i = 1; i < s; ++i) {
+        v = sub(context.multiply(v, v), add(q_power, q_power));
+        if (!v)
+            return true;
+        q_power = context.multiply(q_power, q_power);
+    }
+    return false;
+}
+
+template<typename Limb, Limb Base, typename Allocator>
+bool basic_bigint<Limb, Base, Allocator>::is_prime() const
+{
+    const int small = small_prime_test();
+    if (small >= 0)
+        return small == 1;
+
+    const montgomery_context context(*this);
+    bigint d = *this - static_cast<unsigned char>(1);
+    const std::size_t s = remove_twos(d);
+    return is_strong_probable_prime(context, bigint{ 2 }, d, s) && is_strong_lucas_probable_prime(context);
+}
+template<typename Limb, Limb Base, typename Allocator>
+void basic_bigint<Limb, Base, Allocator>::apply_cofactors(bigint& a, bigint& b, std::int64_t p, std::int64_t q, std::int64_t r, std::int64_t s)
+{
+    using SignedDoubleWidthType = typename double_width<typename std::make_signed<number_type>::type>::type;
+    const std::size_t n = a.mNumbers.size();
+    b.mNumbers.resize(n, 0);
+    // |cofactor| <= B keeps both sums within 2 * B^2 + B, adding 3 * B^2
+    // makes them positive for div_base and 3 * B comes back off the carry
+    const auto offset = static_cast<SignedDoubleWidthType>(3) * kMaxDigitsInNumber * kMaxDigitsInNumber;
+    const auto offset_carry = 3 * static_cast<std::int64_t>(kMaxDigitsInNumber);
+    std::int64_t carry_a = 0;
+    std::int64_t carry_b = 0;
+    for (std::size_t i = 0; i < n; ++i) {
+        const auto x = static_cast<SignedDoubleWidthType>(a.mNumbers[i]);
+        const auto y = static_cast<SignedDoubleWidthType>(b.mNumbers[i]);
+        const SignedDoubleWidthType t = p * x + q * y + carry_a + offset;
+        carry_a = static_cast<std::int64_t>(div_base(static_cast<DoubleWidthType>(t), a.mNumbers[i])) - offset_carry;
+
+        const SignedDoubleWidthType u = r * x + s * y + carry_b + offset;
+        carry_b = static_cast<std::int64_t>(div_base(static_cast<DoubleWidthType>(u), b.mNumbers[i])) - offset_carry;
+    }
+    a.fix();
+    b.fix();
+}
+
+template<typename Limb, Limb Base, typename Allocator>
+void basic_bigint<Limb, Base, Allocator>::gcd_lehmer(bigint& a, bigint& b, bigint* s0, bigint* s1)
+{
+    const auto base = static_cast<std::int64_t>(kMaxDigitsInNumber);
+    bigint quotient{ a.get_allocator() };
+    bigint remainder{ a.get_allocator() };
+    while (b) {
+        const std::size_t n = a.mNumbers.size();
+        // a fits in a 64 bit word
+        if (n * kDigitCountOfMax <= 18) {
+            auto x = a.to<std::uint64_t>();
+            auto y = b.to<std::uint64_t>();
+            while (y != 0) {
+                const std::uint64_t q = x / y;
+                x -= q * y;
+                std::swap(x, y);
+                if (s0) {
+                    *s0 -= *s1 * q;
+                    s0->swap(*s1);
+                }
+            }
+            a = x;
+            b = bigint{};
+            return;
+        }
+
+        // knuth's algorithm L on the top two limbs, (x, y) stays between
+        // (a + A, b + C) and (a + B, b + D) scaled down by B^(n - 2) while the quotients agree
+        std::int64_t A = 1, B = 0, C = 0, D = 1;
+        if (b.mNumbers.size() + 1 >= n) {
+            DoubleWidthType top_a = static_cast<DoubleWidthType>(a.mNumbers[n - 1]) * kMaxDigitsInNumber + a.mNumbers[n - 2];
+            DoubleWidthType top_b = (b.mNumbers.size() == n ? static_cast<DoubleWidthType>(b.mNumbers[n - 1]) * kMaxDigitsInNumber : 0) + b.mNumbers[n - 2];
+            // more than 18 digits overflow the cofactor arithmetic, scaling both down
+            // by the same power of ten keeps the top 18 digits and the bounds above
+            const std::size_t digits = math::digit_count(a.mNumbers[n - 1]) + kDigitCountOfMax;
+            if (digits > 18) {
+                const auto scale = static_cast<number_type>(math::pow10(digits - 18));
+                top_a /= scale;
+                top_b /= scale;
+            }
+            auto x = static_cast<std::int64_t>(top_a);
+            auto y = static_cast<std::int64_t>(top_b);
+            for (;;) {
+                if (y + C <= 0 || y + D <= 0)
+                    break;
+                const std::int64_t q = (x + A) / (y + C);
+                if (q != (x + B) / (y + D))
+                    break;
+                const std::int64_t next_c = A - q * C;
+                const std::int64_t next_d = B - q * D;
+                if (next_c > base || next_c < -base || next_d > base || next_d < -base)
+                    break;
+                A = C;
+                C = next_c;
+                B = D;
+                D = next_d;
+                const std::int64_t t = x - q * y;
+                x = y;
+                y = t;
+            }
+        }
+
+        if (B == 0) {
+            // the top limbs say nothing (or b is much shorter), take a full euclid step
+            bigint::divmod(a, b, quotient, remainder);
+            a.swap(b);
+            b.swap(remainder);
+            if (s0) {
+                *s0 -= quotient * *s1;
+                s0->swap(*s1);
+            }
+            continue;
+        }
+
+        apply_cofactors(a, b, A, B, C, D);
+        if (s0) {
+            bigint next_s0 = *s0 * A + *s1 * B;
+            *s1 = *s0 * C + *s1 * D;
+            s0->swap(next_s0);
+        }
+    }
+}
+
+template<typename Limb, Limb Base, typename Allocator>
+basic_bigint<Limb, Base, Allocator> gcd(basic_bigint<Limb, Base, Allocator> a, basic_bigint<Limb, Base, Allocator> b)
+{
+    using bigint = basic_bigint<Limb, Base, Allocator>;
+    a.set_positive();
+    b.set_positive();
+    if (a < b)
+        a.swap(b);
+
+    bigint::gcd_lehmer(a, b, nullptr, nullptr);
+    return a;
+}
+
+template<typename Limb, Limb Base, typename Allocator>
+std::tuple<basic_bigint<Limb, Base, Allocator>, basic_bigint<Limb, Base, Allocator>, basic_bigint<Limb, Base, Allocator>> xgcd(const basic_bigint<Limb, Base, Allocator>& a, const basic_bigint<Limb, Base, Allocator>& b)
+{
+    using bigint = basic_bigint<Limb, Base, Allocator>;
+    const bool swapped = bigint::lt(a, b, false, false);
+    const bigint& first = swapped ? b : a;
+    const bigint& second = swapped ? a : b;
+
+    bigint g = abs(first);
+    bigint r = abs(second);
+    bigint s0 = 1;
+    bigint s1 = 0;
+    bigint::gcd_lehmer(g, r, &s0, &s1);
+
+    // g == s0 * abs(first) + t * abs(second)
+    bigint t = second ? (g - s0 * abs(first)) / abs(second) : bigint{};
+    if (first.is_negative())
+        s0.flip_sign();
+    if (second.is_negative())
+        t.flip_sign();
+
+    if (swapped)
+        return std::make_tuple(std::move(g), std::move(t), std::move(s0));
+    return std::make_tuple(std::move(g), std::move(s0), std::move(t));
+}
+
+template<typename Limb, Limb Base, typename Allocator>
+basic_bigint<Limb, Base, Allocator> invmod(const basic_bigint<Limb, Base, Allocator>& a, const basic_bigint<Limb, Base, Allocator>& m)
+{
+    using bigint = basic_bigint<Limb, Base, Allocator>;
+    if (m <= static_cast<unsigned char>(0))
+        throw std::invalid_argument("zxshady::invmod(const bigint& a, const bigint& m) m must be positive");
+
+    bigint r = a % m;
+    if (r.is_negative())
+        r += m;
+
+    // only the multiple of r is needed, gcd(m, r) == t * m + s * r
+    bigint g = m;
+    bigint s = 0;
+    bigint s1 = 1;
+    bigint::gcd_lehmer(g, r, &s, &s1);
+    if (g != static_cast<unsigned char>(1))
+        throw std::domain_error("zxshady::invmod(const bigint& a, const bigint& m) a is not invertible modulo m");
+
+    s %= m;
+    if (s.is_negative())
+        s += m;
+    return s;
+}
+
+template<typename Limb, Limb Base, typename Allocator>
+basic_bigint<Limb, Base, Allocator> lcm(const basic_bigint<Limb, Base, Allocator>& a, const basic_bigint<Limb, Base, Allocator>& b)
+{
+    using bigint = basic_bigint<Limb, Base, Allocator>;
+    if (!a || !b ) // using negation operator! to check for == 0 since it is hardcoded it is faster!
+        return bigint{};
+    return abs(a * b) / gcd(a, b);
+
+}
+template<typename Limb, Limb Base, typename Allocator>
+std::ostream& operator<<(std::ostream& ostream, const basic_bigint<Limb, Base, Allocator>& bignum)
+{
+    using bigint = basic_bigint<Limb, Base, Allocator>;
+
+    if (bignum.is_negative()) {
+        ostream << '-';
+    }
+    else if ((ostream.flags() & std::ios_base::showpos) != 0) {
+        if (bignum /* != 0 */)
+            ostream << '+';
+    }
+    const bool showbase = (ostream.flags() & std::ios_base::showbase) != 0;
+    const bool uppercase = (ostream.flags() & std::ios_base::uppercase) != 0;
+
+    std::ios_base::fmtflags base = ostream.flags() & ostream.basefield;
+    // the short division kernel takes divisors up to kMaxSmallDivisor, and below 2^64 for the word fast path,
+    // hex and octal peel off as many digits per pass as such a power of 2 holds
+    constexpr std::size_t kPassBits = bigint::kMaxSmallDivisor >> 63 != 0 ? 63 : math::constexpr_log(static_cast<unsigned long long>(bigint::kMaxSmallDivisor), 2);
+    if ((base & std::ios_base::dec) != 0) {
+        auto iter = bignum.mNumbers.crbegin();
+        const auto end = bignum.mNumbers.crend();
+
+        details::bigint::int_into_stream(*iter, ostream);
+        ++iter;
+        for (; iter != end; ++iter) {
+            auto val = *iter;
+            auto cnt = zxshady::math::digit_count(val);
+            auto difference = bigint::kDigitCountOfMax - cnt;
+
+            static constexpr const char* zeroes[] = {
+                "",
+                "0",
+                "00",
+                "000",
+                "0000",
+                "00000",
+                "000000",
+                "0000000",
+                "00000000",
+                "000000000",
+                "0000000000",
+                "00000000000",
+                "000000000000",
+                "0000000000000",
+                "00000000000000",
+                "000000000000000",
+                "0000000000000000",
+                "00000000000000000",
+                "000000000000000000",
+                "0000000000000000000",
+                "00000000000000000000",
+                "000000000000000000000",
+                "0000000000000000000000",
+                "00000000000000000000000",
+                "000000000000000000000000"
+            };
+            assert(difference < sizeof(zeroes) / sizeof(zeroes[0]));
+            ostream << zeroes[difference];
+            details::bigint::int_into_stream(*iter, ostream);
+
+        }
+    }
+    else if ((base & std::ios_base::hex) != 0) {
+        // 8 hex digits (16^8) per pass with 32 bit limbs, 15 with 64 bit limbs
+        constexpr int kDigitsPerPass = static_cast<int>(kPassBits / 4);
+        auto x = bignum.mNumbers;
+        std::size_t used = x.size();
+        std::size_t size = sizeof(typename bigint::number_type) * CHAR_BIT * bignum.mNumbers.size() + kDigitsPerPass;
+        std::unique_ptr<char[]> buffer(new char[size]);
+        std::ptrdiff_t i = 0;
+        
+        if (showbase) {
+            ostream.put('0');
+            ostream.put(uppercase ? 'X' : 'x');
+        }
+
+        constexpr static char table_lower[] = {
+            '0','1','2','3','4','5','6','7',
+            '8','9','a','b','c','d','e','f'
+        };
+
+        constexpr static char table_upper[] = {
+            '0','1','2','3','4','5','6','7',
+            '8','9','A','B','C','D','E','F'
+        };
+        static_assert(sizeof(table_lower) == 16, "wrong size");
+        static_assert(sizeof(table_upper) == 16, "wrong size");
+        // 17
+        const auto& table = uppercase ? table_upper : table_lower;
+        do {
+            auto chunk = bigint::div_limbs_small(&x[0], used, typename bigint::DoubleWidthType{ 1 } << (4 * kDigitsPerPass));
+            while (used > 1 && x[used - 1] == 0)
+                --used;
+            for (int digit = 0; digit < kDigitsPerPass; ++digit) {
+                buffer[static_cast<std::size_t>(i)] = table[chunk % 16];
+                i++;
+                chunk /= 16;
+            }
+        } while (used > 1 || x[0] != 0);
+
+        while (i > 1 && buffer[i - 1] == '0')
+            --i;
+        for (; i > 0; --i) {
+            ostream.put(buffer[i-1]);
+        }
+    }
+    else if ((base & std::ios_base::oct) != 0) {
+        // 11 octal digits (8^11) per pass with 32 bit limbs, 21 with 64 bit limbs
+        constexpr int kDigitsPerPass = static_cast<int>(kPassBits / 3);
+        auto x = bignum.mNumbers;
+        std::size_t used = x.size();
+        std::size_t size = (3 * bignum.digit_count())/2 + kDigitsPerPass;
+        std::unique_ptr<char[]> buffer(new char[size]);
+        std::ptrdiff_t i = 0;
+
+        if (showbase) {
+            ostream.put('0');
+            ostream.put(uppercase ? 'O' : 'o');
+        }
+
+        do {
+            auto chunk = bigint::div_limbs_small(&x[0], used, typename bigint::DoubleWidthType{ 1 } << (3 * kDigitsPerPass));
+            while (used > 1 && x[used - 1] == 0)
+                --used;
+            for (int digit = 0; digit < kDigitsPerPass; ++digit) {
+                buffer[static_cast<std::size_t>(i)] = static_cast<char>((chunk % 8) + '0');
+                i++;
+                chunk /= 8;
+            }
+        } while (used > 1 || x[0] != 0);
+
+        while (i > 1 && buffer[i - 1] == '0')
+            --i;
+        for (; i > 0; --i) {
+            ostream.put(buffer[i-1]);
+        }
+    }
+
+    /*
+    else if ((base & std::ios_base::binary) != 0) {
+        auto x = bignum;
+        std::unique_ptr<char[]> buffer(
+            new char[sizeof(typename bigint::number_type) * CHAR_BIT * bignum.mNumbers.size()]);
+        std::ptrdiff_t i = 0;
+
+        if (showbase) {
+            ostream.put('0');
+            ostream.put(uppercase ? 'B' : 'b');
+        }
+
+        do {
+            buffer[static_cast<std::size_t>(i)] = x.is_odd() + '0';
+            i++;
+            x.half();
+        } while (x);
+
+        for (; i > 0; --i) {
+            ostream.put(buffer[i-1]);
+        }
+    }
+    */
+    return ostream;
+}
+template<typename Limb, Limb Base, typename Allocator>
+std::istream& operator>>(std::istream& istream, basic_bigint<Limb, Base, Allocator>& bignum)
+{
+    std::string s;
+    istream >> s;
+    if (istream.good())
+        bignum = s;
+    else
+        bignum.zero();
+    return istream;
+}
+
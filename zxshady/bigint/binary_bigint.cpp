@@ -0,0 +1,1048 @@
+
+#include <stdexcept>
+#include <algorithm>
+#include <bitset>
+#include <iostream>
+#include <limits>
+#include <vector>
+
+#include "binary_bigint.hpp"
+
+using namespace zxshady;
+
+using limb_type = binary_bigint::limb_type;
+using double_limb_type = binary_bigint::double_limb_type;
+using storage_type = binary_bigint::storage_type;
+
+constexpr int kLimbBits = binary_bigint::kLimbBits;
+
+// the largest power of 10 that fits in a limb and its number of zeroes
+constexpr limb_type kDecimalChunk = sizeof(limb_type) == 8
+    ? static_cast<limb_type>(10000000000000000000ull)
+    : static_cast<limb_type>(1000000000);
+constexpr std::size_t kDecimalChunkDigits = sizeof(limb_type) == 8 ? 19 : 9;
+
+// leading zero bits of a limb, x must not be 0
+static unsigned leading_zeros(limb_type x) noexcept
+{
+    unsigned count = 0;
+    for (unsigned half = kLimbBits / 2; half != 0; half /= 2) {
+        if ((x >> (kLimbBits - half)) == 0) {
+            count += half;
+            x = static_cast<limb_type>(x << half);
+        }
+    }
+    return count;
+}
+
+// trailing zero bits of a limb, x must not be 0
+static unsigned trailing_zeros(limb_type x) noexcept
+{
+    unsigned count = 0;
+    for (unsigned half = kLimbBits / 2; half != 0; half /= 2) {
+        if ((x & ((limb_type{ 1 } << half) - 1)) == 0) {
+            count += half;
+            x >>= half;
+        }
+    }
+    return count;
+}
+
+static void trim(storage_type& x) noexcept
+{
+    while (x.size() > 1 && x.back() == 0)
+        x.pop_back();
+}
+
+// -1, 0 or 1 as a is below, equal to or above b, both without leading zero limbs
+// (or of the same size)
+static int compare_limbs(const limb_type* a, std::size_t asize, const limb_type* b, std::size_t bsize) noexcept
+{
+    if (asize != bsize)
+        return asize < bsize ? -1 : 1;
+
+    for (std::size_t i = asize; i-- > 0;) {
+        if (a[i] != b[i])
+            return a[i] < b[i] ? -1 : 1;
+    }
+    return 0;
+}
+
+// r = a + b for asize >= bsize, returns the carry out of the top limb, r may be a or b
+static limb_type add_limbs(limb_type* r, const limb_type* a, std::size_t asize, const limb_type* b, std::size_t bsize) noexcept
+{
+    limb_type carry = 0;
+    std::size_t i = 0;
+    for (; i < bsize; ++i) {
+        const double_limb_type sum = static_cast<double_limb_type>(a[i]) + b[i] + carry;
+        r[i] = static_cast<limb_type>(sum);
+        carry = static_cast<limb_type>(sum >> kLimbBits);
+    }
+    for (; i < asize; ++i) {
+        const limb_type sum = a[i] + carry;
+        carry = sum < carry;
+        r[i] = sum;
+    }
+    return carry;
+}
+
+// r = a - b for asize >= bsize, returns the borrow out of the top limb, r may be a or b
+static limb_type sub_limbs(limb_type* r, const limb_type* a, std::size_t asize, const limb_type* b, std::size_t bsize) noexcept
+{
+    limb_type borrow = 0;
+    std::size_t i = 0;
+    for (; i < bsize; ++i) {
+        const limb_type x = a[i];
+        const limb_type y = b[i];
+        const limb_type difference = x - y;
+        r[i] = difference - borrow;
+        borrow = static_cast<limb_type>((x < y) | (difference < borrow));
+    }
+    for (; i < asize; ++i) {
+        const limb_type x = a[i];
+        r[i] = x - borrow;
+        borrow = x < borrow;
+    }
+    return borrow;
+}
+
+// r = a * m, returns the limb carried out, r may be a
+static limb_type mul_1(limb_type* r, const limb_type* a, std::size_t size, limb_type m) noexcept
+{
+    limb_type carry = 0;
+    for (std::size_t i = 0; i < size; ++i) {
+        const double_limb_type product = static_cast<double_limb_type>(a[i]) * m + carry;
+        r[i] = static_cast<limb_type>(product);
+        carry = static_cast<limb_type>(product >> kLimbBits);
+    }
+    return carry;
+}
+
+// r += a * m, returns the limb carried out
+static limb_type addmul_1(limb_type* r, const limb_type* a, std::size_t size, limb_type m) noexcept
+{
+    limb_type carry = 0;
+    for (std::size_t i = 0; i < size; ++i) {
+        const double_limb_type sum = static_cast<double_limb_type>(a[i]) * m + r[i] + carry;
+        r[i] = static_cast<limb_type>(sum);
+        carry = static_cast<limb_type>(sum >> kLimbBits);
+    }
+    return carry;
+}
+
+// r -= a * m, returns the limb borrowed from above r
+static limb_type submul_1(limb_type* r, const limb_type* a, std::size_t size, limb_type m) noexcept
+{
+    limb_type borrow = 0;
+    for (std::size_t i = 0; i < size; ++i) {
+        const double_limb_type product = static_cast<double_limb_type>(a[i]) * m + borrow;
+        const limb_type low = static_cast<limb_type>(product);
+        // the high half is at most B - 2 when the low half is not 0, so this never wraps
+        borrow = static_cast<limb_type>(product >> kLimbBits) + (r[i] < low);
+        r[i] -= low;
+    }
+    return borrow;
+}
+
+// r = a << shift for shift in [0, kLimbBits), returns the bits shifted out, r may be a
+static limb_type shift_left_limbs(limb_type* r, const limb_type* a, std::size_t size, unsigned shift) noexcept
+{
+    if (shift == 0) {
+        std::copy_backward(a, a + size, r + size);
+        return 0;
+    }
+
+    const limb_type out = a[size - 1] >> (kLimbBits - shift);
+    for (std::size_t i = size - 1; i > 0; --i)
+        r[i] = static_cast<limb_type>(a[i] << shift) | (a[i - 1] >> (kLimbBits - shift));
+    r[0] = static_cast<limb_type>(a[0] << shift);
+    return out;
+}
+
+// r = a >> shift for shift in [0, kLimbBits), r may be a
+static void shift_right_limbs(limb_type* r, const limb_type* a, std::size_t size, unsigned shift) noexcept
+{
+    if (shift == 0) {
+        std::copy(a, a + size, r);
+        return;
+    }
+
+    for (std::size_t i = 0; i + 1 < size; ++i)
+        r[i] = (a[i] >> shift) | static_cast<limb_type>(a[i + 1] << (kLimbBits - shift));
+    r[size - 1] = a[size - 1] >> shift;
+}
+
+// out[0, asize + bsize) = a * b
+static void mul_schoolbook(const limb_type* a, std::size_t asize, const limb_type* b, std::size_t bsize, limb_type* out) noexcept
+{
+    std::fill(out, out + asize, limb_type{ 0 });
+    for (std::size_t j = 0; j < bsize; ++j)
+        out[asize + j] = addmul_1(out + j, a, asize, b[j]);
+}
+
+static void mul_limbs(const limb_type* a, std::size_t asize, const limb_type* b, std::size_t bsize, limb_type* out);
+
+// below 4 limbs the middle product (h + 1 limbs) would be as long as the operands
+static_assert(binary_bigint::kKaratsubaThreshold >= 4, "ZXSHADY_BINARY_BIGINT_KARATSUBA_THRESHOLD must be at least 4");
+
+// a * b with a = a1 * B^h + a0 and b = b1 * B^h + b0 from the three products a0 * b0, a1 * b1
+// and (a0 + a1) * (b0 + b1), needs h <= bsize <= asize for h = ceil(asize / 2)
+static void mul_karatsuba(const limb_type* a, std::size_t asize, const limb_type* b, std::size_t bsize, limb_type* out)
+{
+    const std::size_t h = (asize + 1) / 2;
+    const std::size_t a1size = asize - h;
+    const std::size_t b1size = bsize - h;
+
+    std::vector<limb_type> asum(h + 1), bsum(h + 1), middle(2 * h + 2);
+    asum[h] = add_limbs(asum.data(), a, h, a + h, a1size);
+    bsum[h] = add_limbs(bsum.data(), b, h, b + h, b1size);
+
+    mul_limbs(a, h, b, h, out);
+    mul_limbs(a + h, a1size, b + h, b1size, out + 2 * h);
+    mul_limbs(asum.data(), h + 1, bsum.data(), h + 1, middle.data());
+
+    sub_limbs(middle.data(), middle.data(), middle.size(), out, 2 * h);
+    sub_limbs(middle.data(), middle.data(), middle.size(), out + 2 * h, a1size + b1size);
+
+    // a0 * b1 + a1 * b0 shifted by h limbs fits in the product, the limbs past it are 0
+    const std::size_t room = asize + bsize - h;
+    const std::size_t length = (std::min)(middle.size(), room);
+    assert(std::all_of(middle.begin() + static_cast<std::ptrdiff_t>(length), middle.end(), [](limb_type limb) { return limb == 0; }));
+    add_limbs(out + h, out + h, room, middle.data(), length);
+}
+
+// out[0, asize + bsize) = a * b, out must not overlap a or b
+static void mul_limbs(const limb_type* a, std::size_t asize, const limb_type* b, std::size_t bsize, limb_type* out)
+{
+    if (asize < bsize) {
+        std::swap(a, b);
+        std::swap(asize, bsize);
+    }
+
+    if (bsize < binary_bigint::kKaratsubaThreshold) {
+        mul_schoolbook(a, asize, b, bsize, out);
+        return;
+    }
+
+    if (2 * bsize <= asize) {
+        // unbalanced, cut a into slices as long as b
+        std::fill(out, out + asize + bsize, limb_type{ 0 });
+        std::vector<limb_type> slice(2 * bsize);
+        for (std::size_t i = 0; i < asize; i += bsize) {
+            const std::size_t size = (std::min)(bsize, asize - i);
+            mul_limbs(a + i, size, b, bsize, slice.data());
+            add_limbs(out + i, out + i, asize + bsize - i, slice.data(), size + bsize);
+        }
+        return;
+    }
+
+    mul_karatsuba(a, asize, b, bsize, out);
+}
+
+// quotient = a / d, returns a % d, quotient may be a
+static limb_type div_1(limb_type* quotient, const limb_type* a, std::size_t size, limb_type d) noexcept
+{
+    double_limb_type remainder = 0;
+    for (std::size_t i = size; i-- > 0;) {
+        const double_limb_type x = (remainder << kLimbBits) | a[i];
+        quotient[i] = static_cast<limb_type>(x / d);
+        remainder = x % d;
+    }
+    return static_cast<limb_type>(remainder);
+}
+
+// knuth's algorithm D, quotient[0, asize - bsize + 1) = a / b and remainder[0, bsize) = a % b
+// for asize >= bsize >= 2 and a non zero top limb of b
+static void div_knuth(const limb_type* a, std::size_t asize, const limb_type* b, std::size_t bsize, limb_type* quotient, limb_type* remainder)
+{
+    // with the top bit of the divisor set every estimate is at most 2 too big
+    const unsigned shift = leading_zeros(b[bsize - 1]);
+    std::vector<limb_type> v(bsize), u(asize + 1);
+    shift_left_limbs(v.data(), b, bsize, shift);
+    u[asize] = shift_left_limbs(u.data(), a, asize, shift);
+
+    const double_limb_type base = static_cast<double_limb_type>(1) << kLimbBits;
+    const limb_type top = v[bsize - 1];
+    const limb_type next = v[bsize - 2];
+    for (std::size_t j = asize - bsize + 1; j-- > 0;) {
+        limb_type* window = &u[j];
+        const double_limb_type numerator = (static_cast<double_limb_type>(window[bsize]) << kLimbBits) | window[bsize - 1];
+        double_limb_type estimate = numerator / top;
+        double_limb_type rest = numerator % top;
+        // the top two limbs of the divisor rule out all but one of the too big estimates
+        while (estimate >= base || estimate * next > ((rest << kLimbBits) | window[bsize - 2])) {
+            --estimate;
+            rest += top;
+            if (rest >= base)
+                break;
+        }
+
+        auto digit = static_cast<limb_type>(estimate);
+        const limb_type borrow = submul_1(window, v.data(), bsize, digit);
+        const limb_type high = window[bsize];
+        window[bsize] = high - borrow;
+        if (high < borrow) {
+            // still one too big, add the divisor back
+            --digit;
+            window[bsize] += add_limbs(window, window, bsize, v.data(), bsize);
+        }
+        quotient[j] = digit;
+    }
+    shift_right_limbs(remainder, u.data(), bsize, shift);
+}
+
+// a / b and a % b for b != 0, both without leading zero limbs, quotient and remainder must not overlap them
+static void divmod_limbs(const limb_type* a, std::size_t asize, const limb_type* b, std::size_t bsize, storage_type& quotient, storage_type& remainder)
+{
+    if (compare_limbs(a, asize, b, bsize) < 0) {
+        remainder.assign(a, asize);
+        quotient.assign(1, 0);
+        return;
+    }
+
+    if (bsize == 1) {
+        quotient.assign(asize, 0);
+        remainder.assign(1, div_1(&quotient[0], a, asize, b[0]));
+    }
+    else {
+        quotient.assign(asize - bsize + 1, 0);
+        remainder.assign(bsize, 0);
+        div_knuth(a, asize, b, bsize, &quotient[0], &remainder[0]);
+    }
+    trim(quotient);
+    trim(remainder);
+}
+
+// -m^-1 mod B for odd m, m * m == 1 mod 8 is right in the low 3 bits and every newton step doubles them
+static limb_type negated_inverse(limb_type m) noexcept
+{
+    limb_type inverse = m;
+    for (int bits = 3; bits < kLimbBits; bits *= 2)
+        inverse = static_cast<limb_type>(inverse * (2 - m * inverse));
+    return static_cast<limb_type>(0 - inverse);
+}
+
+// out = a * b / B^size mod modulus for a and b in [0, modulus) and an odd modulus,
+// product holds 2 * size + 1 limbs, out may be a or b
+static void montgomery_multiply(const limb_type* a, const limb_type* b, const limb_type* modulus, std::size_t size, limb_type inverse, limb_type* product, limb_type* out)
+{
+    mul_limbs(a, size, b, size, product);
+    product[2 * size] = 0;
+    // adding the multiple of the modulus that clears the lowest limb, once per limb
+    for (std::size_t i = 0; i < size; ++i) {
+        const auto factor = static_cast<limb_type>(product[i] * inverse);
+        limb_type carry = addmul_1(product + i, modulus, size, factor);
+        for (std::size_t k = i + size; carry != 0; ++k) {
+            const limb_type sum = product[k] + carry;
+            carry = sum < carry;
+            product[k] = sum;
+        }
+    }
+
+    // below 2 * modulus here
+    limb_type* result = product + size;
+    if (result[size] != 0 || compare_limbs(result, size, modulus, size) >= 0)
+        sub_limbs(result, result, size + 1, modulus, size);
+    std::copy(result, result + size, out);
+}
+
+// value of a digit in bases up to 36, 36 for any other character
+static int digit_value(char c) noexcept
+{
+    if (c >= '0' && c <= '9')
+        return c - '0';
+    if (c >= 'a' && c <= 'z')
+        return c - 'a' + 10;
+    if (c >= 'A' && c <= 'Z')
+        return c - 'A' + 10;
+    return 36;
+}
+
+// `count` bits of the limbs starting at bit `first`, count < kLimbBits
+static unsigned bits_at(const storage_type& limbs, std::size_t first, unsigned count) noexcept
+{
+    const std::size_t index = first / kLimbBits;
+    const unsigned shift = first % kLimbBits;
+    limb_type value = index < limbs.size() ? limbs[index] >> shift : 0;
+    if (shift + count > kLimbBits && index + 1 < limbs.size())
+        value |= static_cast<limb_type>(limbs[index + 1] << (kLimbBits - shift));
+    return static_cast<unsigned>(value & ((limb_type{ 1 } << count) - 1));
+}
+
+binary_bigint::binary_bigint(const bigint& x)
+    : mIsNegative(x.is_negative())
+{
+    constexpr std::size_t kWordsPerLimb = sizeof(limb_type) / sizeof(std::uint32_t);
+    const std::vector<std::uint32_t> words = x.to_words();
+    mNumbers.assign((words.size() + kWordsPerLimb - 1) / kWordsPerLimb, 0);
+    for (std::size_t i = 0; i < words.size(); ++i)
+        mNumbers[i / kWordsPerLimb] |= static_cast<limb_type>(static_cast<limb_type>(words[i]) << (32 * (i % kWordsPerLimb)));
+    if (mNumbers.empty())
+        mNumbers.push_back(0);
+}
+
+bigint binary_bigint::to_bigint() const
+{
+    std::vector<std::uint32_t> words;
+    words.reserve(mNumbers.size() * sizeof(limb_type) / sizeof(std::uint32_t));
+    for (const limb_type limb : mNumbers) {
+        for (std::size_t shift = 0; shift < sizeof(limb_type) * CHAR_BIT; shift += 32)
+            words.push_back(static_cast<std::uint32_t>(limb >> shift));
+    }
+    while (!words.empty() && words.back() == 0)
+        words.pop_back();
+
+    bigint ret = bigint::from_words(words);
+    ret.set_sign(mIsNegative);
+    return ret;
+}
+
+void binary_bigint::parse(const char* str, std::size_t size, int base, bool prefix, char seperator)
+{
+    const char* const end = str + size;
+    bool negative = false;
+    if (str != end && (*str == '-' || *str == '+')) {
+        negative = *str == '-';
+        ++str;
+    }
+    if (prefix && end - str > 2 && str[0] == '0') {
+        switch (str[1]) {
+            case 'X':
+            case 'x':
+                base = bigint::base::hex;
+                str += 2;
+                break;
+            case 'B':
+            case 'b':
+                base = bigint::base::bin;
+                str += 2;
+                break;
+            case 'O':
+            case 'o':
+                base = bigint::base::oct;
+                str += 2;
+                break;
+        }
+    }
+
+    std::string digits;
+    digits.reserve(static_cast<std::size_t>(end - str));
+    for (const char* it = str; it != end; ++it) {
+        if (seperator != bigint::no_seperator && *it == seperator)
+            continue;
+        const int value = digit_value(*it);
+        if (value >= base)
+            throw zxshady::bigint_format_error("zxshady::bigint_format_error: invalid character at " + std::to_string(it - str) + " character was " + std::string(1, *it));
+        if (value != 0 || !digits.empty())
+            digits.push_back(static_cast<char>(value));
+    }
+
+    if (base == bigint::base::dec) {
+        // 3.33 bits per digit, the long ones are split recursively by bigint
+        if (digits.size() > kDecimalThreshold * 3 / 10) {
+            for (auto& digit : digits)
+                digit = static_cast<char>(digit + '0');
+            *this = binary_bigint(bigint(digits));
+        }
+        else {
+            mNumbers.assign(1, 0);
+            for (std::size_t i = 0; i < digits.size();) {
+                const std::size_t count = (std::min)(kDecimalChunkDigits, digits.size() - i);
+                limb_type chunk = 0;
+                limb_type scale = 1;
+                for (std::size_t k = 0; k < count; ++k, ++i) {
+                    chunk = chunk * 10 + static_cast<limb_type>(digits[i]);
+                    scale *= 10;
+                }
+                limb_type carry = mul_1(&mNumbers[0], mNumbers.data(), mNumbers.size(), scale);
+                carry += add_limbs(&mNumbers[0], mNumbers.data(), mNumbers.size(), &chunk, 1);
+                if (carry != 0)
+                    mNumbers.push_back(carry);
+            }
+        }
+    }
+    else {
+        // every digit is a fixed number of bits, placed from the least significant one
+        const unsigned bits = base == bigint::base::hex ? 4 : base == bigint::base::oct ? 3 : 1;
+        mNumbers.assign((digits.size() * bits + kLimbBits - 1) / kLimbBits + 1, 0);
+        std::size_t position = 0;
+        for (auto it = digits.crbegin(); it != digits.crend(); ++it, position += bits) {
+            const auto value = static_cast<limb_type>(*it);
+            const std::size_t index = position / kLimbBits;
+            const unsigned shift = position % kLimbBits;
+            mNumbers[index] |= static_cast<limb_type>(value << shift);
+            if (shift + bits > kLimbBits)
+                mNumbers[index + 1] |= value >> (kLimbBits - shift);
+        }
+    }
+
+    mIsNegative = negative;
+    fix();
+}
+
+void binary_bigint::add(const limb_type* b, std::size_t bsize, bool b_negative)
+{
+    if (b == mNumbers.data()) {
+        // x += x and x -= x, the storage below is about to change
+        const storage_type copy(b, bsize);
+        add(copy.data(), copy.size(), b_negative);
+        return;
+    }
+    if (bsize == 1 && b[0] == 0)
+        return;
+
+    const std::size_t asize = mNumbers.size();
+    if (mIsNegative == b_negative) {
+        limb_type carry;
+        if (asize >= bsize) {
+            carry = add_limbs(&mNumbers[0], mNumbers.data(), asize, b, bsize);
+        }
+        else {
+            mNumbers.resize(bsize, 0);
+            carry = add_limbs(&mNumbers[0], b, bsize, mNumbers.data(), asize);
+        }
+        if (carry != 0)
+            mNumbers.push_back(carry);
+        return;
+    }
+
+    const int order = compare_limbs(mNumbers.data(), asize, b, bsize);
+    if (order == 0) {
+        zero();
+        return;
+    }
+    if (order > 0) {
+        sub_limbs(&mNumbers[0], mNumbers.data(), asize, b, bsize);
+    }
+    else {
+        mNumbers.resize(bsize, 0);
+        sub_limbs(&mNumbers[0], b, bsize, mNumbers.data(), asize);
+        mIsNegative = b_negative;
+    }
+    fix();
+}
+
+void binary_bigint::multiply(const limb_type* b, std::size_t bsize, bool b_negative)
+{
+    const bool negative = mIsNegative != b_negative;
+    if (bsize == 1) {
+        const limb_type carry = mul_1(&mNumbers[0], mNumbers.data(), mNumbers.size(), b[0]);
+        if (carry != 0)
+            mNumbers.push_back(carry);
+    }
+    else {
+        storage_type product(mNumbers.size() + bsize, 0);
+        mul_limbs(mNumbers.data(), mNumbers.size(), b, bsize, &product[0]);
+        mNumbers.swap(product);
+    }
+    mIsNegative = negative;
+    fix();
+}
+
+void binary_bigint::divide(const limb_type* b, std::size_t bsize, bool b_negative, bool remainder)
+{
+    if (bsize == 1 && b[0] == 0)
+        throw std::invalid_argument("zxshady::binary_bigint::operator/ Division by zero.");
+
+    storage_type quotient, rest;
+    divmod_limbs(mNumbers.data(), mNumbers.size(), b, bsize, quotient, rest);
+    if (remainder) {
+        mNumbers.swap(rest);
+    }
+    else {
+        mNumbers.swap(quotient);
+        mIsNegative = mIsNegative != b_negative;
+    }
+    fix();
+}
+
+int binary_bigint::compare(const limb_type* b, std::size_t bsize, bool b_negative) const noexcept
+{
+    b_negative = b_negative && !(bsize == 1 && b[0] == 0);
+    if (mIsNegative != b_negative)
+        return mIsNegative ? -1 : 1;
+
+    const int order = compare_limbs(mNumbers.data(), mNumbers.size(), b, bsize);
+    return mIsNegative ? -order : order;
+}
+
+std::pair<binary_bigint, binary_bigint> binary_bigint::divmod(const binary_bigint& a, const binary_bigint& b)
+{
+    std::pair<binary_bigint, binary_bigint> ret;
+    divmod(a, b, ret.first, ret.second);
+    return ret;
+}
+
+void binary_bigint::divmod(const binary_bigint& a, const binary_bigint& b, binary_bigint& quotient, binary_bigint& remainder)
+{
+    if (!b)
+        throw std::invalid_argument("zxshady::binary_bigint::divmod Division by zero.");
+
+    storage_type q, r;
+    divmod_limbs(a.mNumbers.data(), a.mNumbers.size(), b.mNumbers.data(), b.mNumbers.size(), q, r);
+    const bool quotient_negative = a.is_negative() != b.is_negative();
+    const bool remainder_negative = a.is_negative();
+
+    quotient.mNumbers.swap(q);
+    quotient.mIsNegative = quotient_negative;
+    quotient.fix();
+    remainder.mNumbers.swap(r);
+    remainder.mIsNegative = remainder_negative;
+    remainder.fix();
+}
+
+std::uint64_t binary_bigint::mod_small(std::uint64_t divisor) const
+{
+    if (divisor == 0)
+        throw std::invalid_argument("zxshady::binary_bigint::mod_small(std::uint64_t divisor) Division by zero.");
+
+    if ((divisor >> (kLimbBits / 2) >> (kLimbBits / 2)) != 0) {
+        // wider than a limb, only with 32 bit limbs
+        binary_bigint quotient, remainder;
+        divmod(abs(*this), binary_bigint(divisor), quotient, remainder);
+        return remainder.to<std::uint64_t>();
+    }
+
+    double_limb_type remainder = 0;
+    for (std::size_t i = mNumbers.size(); i-- > 0;)
+        remainder = ((remainder << kLimbBits) | mNumbers[i]) % divisor;
+    return static_cast<std::uint64_t>(remainder);
+}
+
+storage_type binary_bigint::twos_complement(std::size_t size) const
+{
+    storage_type limbs(size, 0);
+    std::copy(mNumbers.begin(), mNumbers.end(), limbs.begin());
+    if (mIsNegative) {
+        // ~(abs - 1), the limbs past the magnitude become all ones
+        for (auto& limb : limbs) {
+            if (limb-- != 0)
+                break;
+        }
+        for (auto& limb : limbs)
+            limb = static_cast<limb_type>(~limb);
+    }
+    return limbs;
+}
+
+void binary_bigint::assign_twos_complement(storage_type limbs)
+{
+    const bool negative = (limbs.back() >> (kLimbBits - 1)) != 0;
+    if (negative) {
+        for (auto& limb : limbs)
+            limb = static_cast<limb_type>(~limb);
+        for (auto& limb : limbs) {
+            if (++limb != 0)
+                break;
+        }
+    }
+    mNumbers.swap(limbs);
+    mIsNegative = negative;
+    fix();
+}
+
+// one limb longer than the longer operand keeps the sign in the top bit of the result
+
+binary_bigint& binary_bigint::operator&=(const binary_bigint& rhs) &
+{
+    const std::size_t size = (std::max)(mNumbers.size(), rhs.mNumbers.size()) + 1;
+    storage_type limbs = twos_complement(size);
+    const storage_type other = rhs.twos_complement(size);
+    for (std::size_t i = 0; i < size; ++i)
+        limbs[i] &= other[i];
+    assign_twos_complement(std::move(limbs));
+    return *this;
+}
+
+binary_bigint& binary_bigint::operator|=(const binary_bigint& rhs) &
+{
+    const std::size_t size = (std::max)(mNumbers.size(), rhs.mNumbers.size()) + 1;
+    storage_type limbs = twos_complement(size);
+    const storage_type other = rhs.twos_complement(size);
+    for (std::size_t i = 0; i < size; ++i)
+        limbs[i] |= other[i];
+    assign_twos_complement(std::move(limbs));
+    return *this;
+}
+
+binary_bigint& binary_bigint::operator^=(const binary_bigint& rhs) &
+{
+    const std::size_t size = (std::max)(mNumbers.size(), rhs.mNumbers.size()) + 1;
+    storage_type limbs = twos_complement(size);
+    const storage_type other = rhs.twos_complement(size);
+    for (std::size_t i = 0; i < size; ++i)
+        limbs[i] ^= other[i];
+    assign_twos_complement(std::move(limbs));
+    return *this;
+}
+
+binary_bigint& binary_bigint::operator>>=(unsigned long long bits) &
+{
+    // a negative number goes one further down when any of the bits shifted out is set
+    const bool round_down = is_negative() && count_trailing_zeros() < bits;
+    div_2exp(bits);
+    if (round_down)
+        *this -= 1;
+    return *this;
+}
+
+binary_bigint& binary_bigint::mul_2exp(unsigned long long exponent) &
+{
+    if (!*this || exponent == 0)
+        return *this;
+
+    const limb_type carry = shift_left_limbs(&mNumbers[0], mNumbers.data(), mNumbers.size(), static_cast<unsigned>(exponent % kLimbBits));
+    if (carry != 0)
+        mNumbers.push_back(carry);
+    mNumbers.insert(0, static_cast<std::size_t>(exponent / kLimbBits), limb_type{ 0 });
+    return *this;
+}
+
+binary_bigint& binary_bigint::div_2exp(unsigned long long exponent) & noexcept
+{
+    if (exponent / kLimbBits >= mNumbers.size()) {
+        zero();
+        return *this;
+    }
+
+    mNumbers.erase(0, static_cast<std::size_t>(exponent / kLimbBits));
+    shift_right_limbs(&mNumbers[0], mNumbers.data(), mNumbers.size(), static_cast<unsigned>(exponent % kLimbBits));
+    fix();
+    return *this;
+}
+
+bool binary_bigint::is_pow_of_2() const noexcept
+{
+    // same answers as bigint::is_pow_of_2, 0 counts and negatives do not
+    if (!*this)
+        return true;
+
+    if (is_negative())
+        return false;
+
+    const limb_type top = mNumbers.back();
+    if (top == 0 || (top & (top - 1)) != 0)
+        return false;
+    return std::all_of(mNumbers.begin(), mNumbers.end() - 1, [](limb_type limb) { return limb == 0; });
+}
+
+std::size_t binary_bigint::bit_length() const noexcept
+{
+    if (!*this)
+        return 0;
+    return mNumbers.size() * kLimbBits - leading_zeros(mNumbers.back());
+}
+
+bool binary_bigint::test_bit(std::size_t index) const noexcept
+{
+    const std::size_t limb = index / kLimbBits;
+    const bool bit = limb < mNumbers.size() && ((mNumbers[limb] >> (index % kLimbBits)) & 1) != 0;
+    if (!mIsNegative)
+        return bit;
+
+    // -x keeps the bits of x up to its lowest set bit and flips the ones above it
+    return index <= count_trailing_zeros() ? bit : !bit;
+}
+
+binary_bigint& binary_bigint::set_bit(std::size_t index, bool value) &
+{
+    if (test_bit(index) == value)
+        return *this;
+
+    // flipping one bit of the two's complement adds or subtracts 2^index
+    const binary_bigint power = binary_bigint(1).mul_2exp(index);
+    return value ? (*this += power) : (*this -= power);
+}
+
+std::size_t binary_bigint::popcount() const noexcept
+{
+    if (mIsNegative)
+        return (std::numeric_limits<std::size_t>::max)();
+
+    std::size_t count = 0;
+    for (const limb_type limb : mNumbers)
+        count += std::bitset<sizeof(limb_type) * CHAR_BIT>(limb).count();
+    return count;
+}
+
+std::size_t binary_bigint::count_trailing_zeros() const noexcept
+{
+    if (!*this)
+        return (std::numeric_limits<std::size_t>::max)();
+
+    std::size_t limb = 0;
+    while (mNumbers[limb] == 0)
+        ++limb;
+    return limb * kLimbBits + trailing_zeros(mNumbers[limb]);
+}
+
+std::string binary_bigint::to_string() const
+{
+    if (bit_length() > kDecimalThreshold)
+        return to_bigint().to_string();
+
+    // peel off kDecimalChunkDigits digits per division by the largest power of 10 in a limb
+    std::string digits;
+    storage_type x = mNumbers;
+    std::size_t used = x.size();
+    do {
+        limb_type chunk = div_1(&x[0], x.data(), used, kDecimalChunk);
+        while (used > 1 && x[used - 1] == 0)
+            --used;
+        const bool last = used == 1 && x[0] == 0;
+        for (std::size_t i = 0; i < kDecimalChunkDigits && (!last || chunk != 0); ++i) {
+            digits.push_back(static_cast<char>('0' + chunk % 10));
+            chunk /= 10;
+        }
+    } while (used > 1 || x[0] != 0);
+
+    if (digits.empty())
+        digits.push_back('0');
+    if (mIsNegative)
+        digits.push_back('-');
+    std::reverse(digits.begin(), digits.end());
+    return digits;
+}
+
+std::size_t binary_bigint::digit_count() const
+{
+    if (!*this)
+        return 1;
+
+    // 10^(digits - 1) <= x < 2^bits gives bits * log10(2) digits or one less, a power of 10 decides
+    const std::size_t bits = bit_length();
+    const auto digits = static_cast<std::size_t>(static_cast<double>(bits - 1) * 0.30102999566398120) + 1;
+    const binary_bigint power = pow10(digits);
+    return compare_limbs(mNumbers.data(), mNumbers.size(), power.mNumbers.data(), power.mNumbers.size()) >= 0 ? digits + 1 : digits;
+}
+
+binary_bigint binary_bigint::pow10(unsigned long long exponent)
+{
+    return pow(binary_bigint(10), exponent);
+}
+
+unsigned long long zxshady::log2(const binary_bigint& x)
+{
+    if (!x)
+        throw std::invalid_argument("zxshady::log2(const binary_bigint& x) input cannot be 0");
+
+    if (x.is_negative())
+        throw std::invalid_argument("zxshady::log2(const binary_bigint& x) input cannot be negative");
+
+    return x.bit_length() - 1;
+}
+
+binary_bigint zxshady::pow(binary_bigint base, unsigned long long exponent)
+{
+    if (exponent == 0)
+        return binary_bigint{ 1 };
+
+    if (!base)
+        return binary_bigint{};
+
+    const bool negative = base.is_negative() && exponent % 2 == 1;
+    base.set_positive();
+
+    // powers of 2 are a single shift
+    if (base.is_pow_of_2()) {
+        const unsigned long long bits = log2(base);
+        if (bits == 0 || exponent <= (std::numeric_limits<unsigned long long>::max)() / bits) {
+            binary_bigint ret = binary_bigint(1).mul_2exp(bits * exponent);
+            ret.set_sign(negative);
+            return ret;
+        }
+    }
+
+    int top = 63;
+    while (((exponent >> top) & 1) == 0)
+        --top;
+
+    binary_bigint ret = base;
+    for (int bit = top - 1; bit >= 0; --bit) {
+        ret *= ret;
+        if (((exponent >> bit) & 1) != 0)
+            ret *= base;
+    }
+    ret.set_sign(negative);
+    return ret;
+}
+
+binary_bigint zxshady::powmod(const binary_bigint& base, const binary_bigint& exponent, const binary_bigint& modulus)
+{
+    if (!modulus.is_positive())
+        throw std::invalid_argument("zxshady::powmod(const binary_bigint& base, const binary_bigint& exponent, const binary_bigint& modulus) modulus must be positive");
+
+    if (exponent.is_negative())
+        throw std::invalid_argument("zxshady::powmod(const binary_bigint& base, const binary_bigint& exponent, const binary_bigint& modulus) exponent cannot be negative");
+
+    if (modulus == 1)
+        return binary_bigint{};
+
+    binary_bigint x = base % modulus;
+    if (x.is_negative())
+        x += modulus;
+
+    const std::size_t bits = exponent.bit_length();
+    if (modulus.is_even()) {
+        binary_bigint ret = 1;
+        for (std::size_t i = bits; i-- > 0;) {
+            ret = ret * ret % modulus;
+            if (exponent.test_bit(i))
+                ret = ret * x % modulus;
+        }
+        return ret;
+    }
+
+    // montgomery form keeps x * B^size mod modulus, a product is reduced by adding
+    // multiples of the modulus that clear its low limbs instead of dividing
+    const std::size_t size = modulus.mNumbers.size();
+    const limb_type* const m = modulus.mNumbers.data();
+    const limb_type inverse = negated_inverse(m[0]);
+    std::vector<limb_type> product(2 * size + 1);
+    const auto to_montgomery = [&](binary_bigint value) {
+        value.mul_2exp(static_cast<unsigned long long>(size) * kLimbBits);
+        value %= modulus;
+        value.mNumbers.resize(size, 0);
+        return value.mNumbers;
+    };
+    const auto multiply = [&](const storage_type& a, const storage_type& b, storage_type& out) {
+        montgomery_multiply(a.data(), b.data(), m, size, inverse, product.data(), &out[0]);
+    };
+
+    // odd powers x^1, x^3, ..., x^(2^window - 1) for a sliding window over the exponent
+    constexpr std::size_t kWindowLimits[] = { 7, 25, 81, 241, 673, 1793 };
+    std::size_t window = 1;
+    while (window <= sizeof(kWindowLimits) / sizeof(kWindowLimits[0]) && bits > kWindowLimits[window - 1])
+        ++window;
+
+    std::vector<storage_type> table(std::size_t{ 1 } << (window - 1));
+    table[0] = to_montgomery(x);
+    if (table.size() > 1) {
+        storage_type square(size, 0);
+        multiply(table[0], table[0], square);
+        for (std::size_t i = 1; i < table.size(); ++i) {
+            table[i].assign(size, 0);
+            multiply(table[i - 1], square, table[i]);
+        }
+    }
+
+    storage_type ret;
+    for (std::size_t i = bits; i > 0;) {
+        if (!exponent.test_bit(i - 1)) {
+            multiply(ret, ret, ret);
+            --i;
+            continue;
+        }
+
+        // the longest run of at most `window` bits from bit i - 1 down that ends in a set bit
+        std::size_t length = (std::min)(window, i);
+        while (!exponent.test_bit(i - length))
+            --length;
+        std::size_t value = 0;
+        for (std::size_t k = 1; k <= length; ++k)
+            value = value * 2 + exponent.test_bit(i - k);
+
+        if (ret.empty()) {
+            ret = table[value / 2];
+        }
+        else {
+            for (std::size_t k = 0; k < length; ++k)
+                multiply(ret, ret, ret);
+            multiply(ret, table[value / 2], ret);
+        }
+        i -= length;
+    }
+
+    if (ret.empty())
+        return binary_bigint{ 1 };
+
+    // out of montgomery form by multiplying with a plain 1
+    storage_type one(size, 0);
+    one[0] = 1;
+    multiply(ret, one, ret);
+
+    binary_bigint result;
+    result.mNumbers.swap(ret);
+    result.fix();
+    return result;
+}
+
+binary_bigint zxshady::sqrt(const binary_bigint& x)
+{
+    if (x.is_negative())
+        throw std::domain_error("zxshady::sqrt(const binary_bigint& x) x must not be negative");
+
+    if (!x)
+        return x;
+
+    // newton steps from 2^ceil(bits / 2) >= sqrt(x) go down until they stop decreasing
+    binary_bigint root = binary_bigint(1).mul_2exp((x.bit_length() + 1) / 2);
+    while (true) {
+        binary_bigint next = (root + x / root).half();
+        if (next >= root)
+            return root;
+        root = std::move(next);
+    }
+}
+
+binary_bigint zxshady::gcd(binary_bigint a, binary_bigint b)
+{
+    a.set_positive();
+    b.set_positive();
+    binary_bigint quotient;
+    while (b) {
+        binary_bigint::divmod(a, b, quotient, a);
+        a.swap(b);
+    }
+    return a;
+}
+
+binary_bigint zxshady::lcm(const binary_bigint& a, const binary_bigint& b)
+{
+    if (!a || !b)
+        return binary_bigint{};
+    return abs(a / gcd(a, b) * b);
+}
+
+std::ostream& zxshady::operator<<(std::ostream& ostream, const binary_bigint& bignum)
+{
+    const std::ios_base::fmtflags flags = ostream.flags();
+    const std::ios_base::fmtflags base = flags & std::ios_base::basefield;
+    if ((base & (std::ios_base::hex | std::ios_base::oct)) == 0) {
+        if ((flags & std::ios_base::showpos) != 0 && bignum.is_positive())
+            ostream << '+';
+        return ostream << bignum.to_string();
+    }
+
+    if (bignum.is_negative())
+        ostream << '-';
+    else if ((flags & std::ios_base::showpos) != 0 && bignum)
+        ostream << '+';
+
+    const bool hex = (base & std::ios_base::hex) != 0;
+    const bool uppercase = (flags & std::ios_base::uppercase) != 0;
+    if ((flags & std::ios_base::showbase) != 0) {
+        ostream.put('0');
+        ostream.put(hex ? (uppercase ? 'X' : 'x') : (uppercase ? 'O' : 'o'));
+    }
+
+    // every digit is a fixed group of bits, read from the top
+    const unsigned bits = hex ? 4 : 3;
+    const char* const table = uppercase ? "0123456789ABCDEF" : "0123456789abcdef";
+    const std::size_t count = (std::max)(std::size_t{ 1 }, (bignum.bit_length() + bits - 1) / bits);
+    std::string digits(count, '0');
+    for (std::size_t i = 0; i < count; ++i)
+        digits[count - 1 - i] = table[bits_at(bignum.mNumbers, i * bits, bits)];
+    return ostream << digits;
+}
+
+std::istream& zxshady::operator>>(std::istream& istream, binary_bigint& bignum)
+{
+    std::string s;
+    istream >> s;
+    if (istream)
+        bignum = s;
+    else
+        bignum.zero();
+    return istream;
+}
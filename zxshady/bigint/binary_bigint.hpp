@@ -0,0 +1,660 @@
+#ifndef ZXSHADY_BINARY_BIGINT_HPP
+#define ZXSHADY_BINARY_BIGINT_HPP
+
+#include <iosfwd>
+
+#include <string>
+#include <type_traits>
+#include <limits>
+#include <stdexcept>
+#include <utility>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <climits>
+
+#include "bigint.hpp"
+
+// limb count (of the smaller operand) at which binary_bigint multiplication
+// switches from the schoolbook loop to karatsuba, define before including to tune it.
+#ifndef ZXSHADY_BINARY_BIGINT_KARATSUBA_THRESHOLD
+#define ZXSHADY_BINARY_BIGINT_KARATSUBA_THRESHOLD 32
+#endif
+
+// bit length up to which binary_bigint converts to and from decimal by itself,
+// longer numbers go through bigint which splits them recursively.
+#ifndef ZXSHADY_BINARY_BIGINT_DECIMAL_THRESHOLD
+#define ZXSHADY_BINARY_BIGINT_DECIMAL_THRESHOLD 4096
+#endif
+
+namespace zxshady {
+
+/// @brief the same integer as bigint kept in full machine word limbs (base 2^64 with 128 bit
+/// products, base 2^32 otherwise) instead of the decimal limbs of bigint. arithmetic, shifts and bitwise operators
+/// work on whole words, decimal digits only exist when converting from and to strings.
+/// @note the decimal digit accessors of bigint (operator[], at, iterators) are not offered,
+/// use to_bigint() for them and for the number theory functions without a binary overload
+class binary_bigint final {
+public:
+#ifdef ZXSHADY_BIGINT_HAS_INT128
+    using limb_type = std::uint64_t;
+#else
+    using limb_type = std::uint32_t;
+#endif
+    using double_limb_type = typename double_width<limb_type>::type;
+    using storage_type = std::basic_string<limb_type>;
+
+    constexpr static int kLimbBits = sizeof(limb_type) * CHAR_BIT;
+    constexpr static std::size_t kKaratsubaThreshold = ZXSHADY_BINARY_BIGINT_KARATSUBA_THRESHOLD;
+    constexpr static std::size_t kDecimalThreshold = ZXSHADY_BINARY_BIGINT_DECIMAL_THRESHOLD;
+
+    // @brief a constructor that initializes the binary_bigint to 0
+    binary_bigint()
+        : mNumbers(1, 0)
+        , mIsNegative(false)
+    {
+    }
+
+    binary_bigint(const binary_bigint&) = default;
+    binary_bigint(binary_bigint&&) noexcept = default;
+    binary_bigint& operator=(const binary_bigint&) & = default;
+    binary_bigint& operator=(binary_bigint&&) & noexcept = default;
+    ~binary_bigint() noexcept = default;
+
+    template<typename Integer, typename std::enable_if<
+        std::is_integral<Integer>::value, int>::type = 0>
+    binary_bigint(Integer num)
+        : mIsNegative(::zxshady::is_negative(num))
+    {
+        limb_type limbs[kIntegerLimbs];
+        mNumbers.assign(limbs, integer_limbs(num, limbs));
+    }
+
+    binary_bigint(std::nullptr_t) = delete;
+
+    /// @brief converts from the decimal limbs of bigint, recursively for long numbers
+    explicit binary_bigint(const bigint& x);
+
+    template<typename InputIter, typename std::enable_if<
+        !std::is_integral<InputIter>::value, int>::type = 0>
+    binary_bigint(InputIter begin, InputIter end, bigint::base base, char seperator = bigint::default_seperator)
+        : binary_bigint()
+    {
+        static_assert(std::is_same<char, typename remove_cvref<decltype(*begin)>::type>::value, "InputIter derefenced must return a char");
+        const std::string str(begin, end);
+        parse(str.c_str(), str.size(), static_cast<int>(base), false, seperator);
+    }
+
+    /// @brief like bigint reads a sign then a 0x, 0b or 0o prefix, decimal without one
+    template<typename InputIter, typename std::enable_if<
+        !std::is_integral<InputIter>::value, int>::type = 0>
+    binary_bigint(InputIter begin, InputIter end, char seperator = bigint::default_seperator)
+        : binary_bigint()
+    {
+        static_assert(std::is_same<char, typename remove_cvref<decltype(*begin)>::type>::value, "InputIter derefenced must return a char");
+        const std::string str(begin, end);
+        parse(str.c_str(), str.size(), 10, true, seperator);
+    }
+
+    binary_bigint(const char* str, std::size_t size) : binary_bigint(str, str + size) {}
+    explicit binary_bigint(const std::string& str) : binary_bigint(str.c_str(), str.c_str() + str.size()) {}
+    explicit binary_bigint(const char* str) : binary_bigint(str, str + std::strlen(str)) {}
+#ifdef __cpp_lib_string_view
+
+    explicit binary_bigint(std::string_view str) : binary_bigint(str.begin(), str.end()) {};
+
+#endif // defined(__cpp_lib_string_view)
+
+    binary_bigint& operator=(const char* s) &
+    {
+        return *this = binary_bigint{ s };
+    }
+
+    binary_bigint& operator=(const std::string& s) &
+    {
+        return *this = binary_bigint{ s };
+    }
+
+    template<typename Integral, typename std::enable_if<
+        std::is_integral<Integral>::value, int>::type = 0>
+    binary_bigint& operator=(Integral num) &
+    {
+        limb_type limbs[kIntegerLimbs];
+        mNumbers.assign(limbs, integer_limbs(num, limbs));
+        mIsNegative = ::zxshady::is_negative(num);
+        return *this;
+    }
+
+    /// @brief the same value in the decimal limbs of bigint
+    ZXSHADY_NODISCARD bigint to_bigint() const;
+
+    template<typename T>
+    ZXSHADY_NODISCARD T to() const
+    {
+        static_assert(std::is_integral<T>::value, "T in zxshady::binary_bigint::to<T>() must be an integral type.");
+
+        const result<T> ret = non_throwing_to<T>();
+        if (!ret)
+            throw std::range_error("zxshady::binary_bigint::to<T>() value cannot be represented it is either too big or too small");
+        return ret.val;
+    }
+
+    template<typename T>
+    ZXSHADY_NODISCARD result<T> non_throwing_to() const noexcept
+    {
+        static_assert(std::is_integral<T>::value, "T in zxshady::binary_bigint::to<T>() must be an integral type.");
+        using unsigned_type = typename std::make_unsigned<T>::type;
+        using wide_type = typename std::conditional<(sizeof(unsigned_type) > sizeof(std::uint64_t)), unsigned_type, std::uint64_t>::type;
+
+        if (bit_length() > static_cast<std::size_t>(std::numeric_limits<unsigned_type>::digits))
+            return { 0,std::errc::result_out_of_range };
+
+        wide_type magnitude = 0;
+        for (std::size_t i = mNumbers.size(); i-- > 0;)
+            magnitude = (magnitude << (kLimbBits / 2) << (kLimbBits / 2)) | mNumbers[i];
+
+        if ZXSHADY_CONSTEXPR17(std::is_signed<T>::value) {
+            const auto max = static_cast<wide_type>((std::numeric_limits<T>::max)());
+            if (magnitude > max + is_negative())
+                return { 0,std::errc::result_out_of_range };
+            // -(magnitude - 1) - 1 never overflows, even for the minimum of T
+            if (is_negative())
+                return result<T>{ static_cast<T>(-static_cast<T>(magnitude - 1) - 1) };
+        }
+        else if (is_negative()) {
+            return { 0,std::errc::result_out_of_range };
+        }
+        return result<T>{ static_cast<T>(magnitude) };
+    }
+
+    ZXSHADY_NODISCARD bool is_negative() const noexcept { return mIsNegative; }
+    ZXSHADY_NODISCARD bool is_positive() const noexcept { return !mIsNegative && *this; }
+
+    /// @brief checks if the binary_bigint is non-zero (faster than *this != 0)
+    ZXSHADY_NODISCARD explicit operator bool() const noexcept
+    {
+        return !!(*this);
+    }
+
+    /// @brief checks if the binary_bigint is zero (faster than *this == 0)
+    ZXSHADY_NODISCARD bool operator!() const noexcept
+    {
+        return mNumbers.size() == 1 && mNumbers[0] == 0;
+    }
+
+    void swap(binary_bigint& that) & noexcept
+    {
+        using std::swap;
+        swap(mIsNegative, that.mIsNegative);
+        swap(mNumbers, that.mNumbers);
+    }
+
+    binary_bigint& operator+=(const binary_bigint& rhs) &
+    {
+        add(rhs.mNumbers.data(), rhs.mNumbers.size(), rhs.is_negative());
+        return *this;
+    }
+
+    template<typename Integer, typename std::enable_if<std::is_integral<Integer>::value, int>::type = 0>
+    binary_bigint& operator+=(Integer rhs) &
+    {
+        limb_type limbs[kIntegerLimbs];
+        add(limbs, integer_limbs(rhs, limbs), ::zxshady::is_negative(rhs));
+        return *this;
+    }
+
+    binary_bigint& operator-=(const binary_bigint& rhs) &
+    {
+        add(rhs.mNumbers.data(), rhs.mNumbers.size(), !rhs.is_negative() && rhs);
+        return *this;
+    }
+
+    template<typename Integer, typename std::enable_if<std::is_integral<Integer>::value, int>::type = 0>
+    binary_bigint& operator-=(Integer rhs) &
+    {
+        limb_type limbs[kIntegerLimbs];
+        add(limbs, integer_limbs(rhs, limbs), !::zxshady::is_negative(rhs) && rhs != 0);
+        return *this;
+    }
+
+    binary_bigint& operator*=(const binary_bigint& rhs) &
+    {
+        multiply(rhs.mNumbers.data(), rhs.mNumbers.size(), rhs.is_negative());
+        return *this;
+    }
+
+    template<typename Integer, typename std::enable_if<std::is_integral<Integer>::value, int>::type = 0>
+    binary_bigint& operator*=(Integer rhs) &
+    {
+        limb_type limbs[kIntegerLimbs];
+        multiply(limbs, integer_limbs(rhs, limbs), ::zxshady::is_negative(rhs));
+        return *this;
+    }
+
+    /// @brief rounds towards zero like the built in integers
+    binary_bigint& operator/=(const binary_bigint& rhs) &
+    {
+        divide(rhs.mNumbers.data(), rhs.mNumbers.size(), rhs.is_negative(), false);
+        return *this;
+    }
+
+    template<typename Integer, typename std::enable_if<std::is_integral<Integer>::value, int>::type = 0>
+    binary_bigint& operator/=(Integer rhs) &
+    {
+        limb_type limbs[kIntegerLimbs];
+        divide(limbs, integer_limbs(rhs, limbs), ::zxshady::is_negative(rhs), false);
+        return *this;
+    }
+
+    /// @brief the remainder has the sign of *this like the built in integers
+    binary_bigint& operator%=(const binary_bigint& rhs) &
+    {
+        divide(rhs.mNumbers.data(), rhs.mNumbers.size(), rhs.is_negative(), true);
+        return *this;
+    }
+
+    template<typename Integer, typename std::enable_if<std::is_integral<Integer>::value, int>::type = 0>
+    binary_bigint& operator%=(Integer rhs) &
+    {
+        limb_type limbs[kIntegerLimbs];
+        divide(limbs, integer_limbs(rhs, limbs), ::zxshady::is_negative(rhs), true);
+        return *this;
+    }
+
+    ZXSHADY_NODISCARD friend bool operator==(const binary_bigint& a, const binary_bigint& b) noexcept
+    {
+        return a.mIsNegative == b.mIsNegative && a.mNumbers == b.mNumbers;
+    }
+
+    ZXSHADY_NODISCARD friend bool operator<(const binary_bigint& a, const binary_bigint& b) noexcept
+    {
+        return a.compare(b.mNumbers.data(), b.mNumbers.size(), b.is_negative()) < 0;
+    }
+
+    template<typename Integer, typename std::enable_if<std::is_integral<Integer>::value, int>::type = 0>
+    ZXSHADY_NODISCARD friend bool operator==(const binary_bigint& a, Integer b) noexcept
+    {
+        limb_type limbs[kIntegerLimbs];
+        return a.compare(limbs, integer_limbs(b, limbs), ::zxshady::is_negative(b)) == 0;
+    }
+
+    template<typename Integer, typename std::enable_if<std::is_integral<Integer>::value, int>::type = 0>
+    ZXSHADY_NODISCARD friend bool operator==(Integer a, const binary_bigint& b) noexcept
+    {
+        return b == a;
+    }
+
+    template<typename Integer, typename std::enable_if<std::is_integral<Integer>::value, int>::type = 0>
+    ZXSHADY_NODISCARD friend bool operator<(const binary_bigint& a, Integer b) noexcept
+    {
+        limb_type limbs[kIntegerLimbs];
+        return a.compare(limbs, integer_limbs(b, limbs), ::zxshady::is_negative(b)) < 0;
+    }
+
+    template<typename Integer, typename std::enable_if<std::is_integral<Integer>::value, int>::type = 0>
+    ZXSHADY_NODISCARD friend bool operator<(Integer a, const binary_bigint& b) noexcept
+    {
+        limb_type limbs[kIntegerLimbs];
+        return b.compare(limbs, integer_limbs(a, limbs), ::zxshady::is_negative(a)) > 0;
+    }
+
+    /// @return -1 if *this < that, 0 if *this == that, 1 if *this > that
+    ZXSHADY_NODISCARD int compare(const binary_bigint& that) const noexcept
+    {
+        return compare(that.mNumbers.data(), that.mNumbers.size(), that.is_negative());
+    }
+
+    // bitwise operators act on the two's complement with infinitely many leading ones for negative
+    binary_bigint& operator&=(const binary_bigint& rhs) &;
+    binary_bigint& operator|=(const binary_bigint& rhs) &;
+    binary_bigint& operator^=(const binary_bigint& rhs) &;
+
+    template<typename Integer, typename std::enable_if<std::is_integral<Integer>::value, int>::type = 0>
+    binary_bigint& operator&=(Integer rhs) &
+    {
+        return *this &= binary_bigint(rhs);
+    }
+
+    template<typename Integer, typename std::enable_if<std::is_integral<Integer>::value, int>::type = 0>
+    binary_bigint& operator|=(Integer rhs) &
+    {
+        return *this |= binary_bigint(rhs);
+    }
+
+    template<typename Integer, typename std::enable_if<std::is_integral<Integer>::value, int>::type = 0>
+    binary_bigint& operator^=(Integer rhs) &
+    {
+        return *this ^= binary_bigint(rhs);
+    }
+
+    /// @brief *this * 2^bits
+    binary_bigint& operator<<=(unsigned long long bits) &
+    {
+        return mul_2exp(bits);
+    }
+
+    /// @brief *this / 2^bits rounded towards negative infinity like an arithmetic shift
+    binary_bigint& operator>>=(unsigned long long bits) &;
+
+    binary_bigint& operator++() &
+    {
+        return *this += 1;
+    }
+
+    binary_bigint& operator--() &
+    {
+        return *this -= 1;
+    }
+
+    ZXSHADY_NODISCARD_MSG("zxshady::binary_bigint::operator++(int) post-fix increment incurs memory allocation (via the required copy) and overhead use prefix increment if you don't intend to use the value.")
+    binary_bigint operator++(int) &
+    {
+        auto copy = *this;
+        ++*this;
+        return copy;
+    }
+
+    ZXSHADY_NODISCARD_MSG("zxshady::binary_bigint::operator--(int) post-fix decrement incurs memory allocation (via the required copy) and overhead use prefix decrement if you don't intend to use the value.")
+    binary_bigint operator--(int) &
+    {
+        auto copy = *this;
+        --*this;
+        return copy;
+    }
+
+    ZXSHADY_NODISCARD bool is_even() const noexcept { return mNumbers[0] % 2 == 0; }
+    ZXSHADY_NODISCARD bool is_odd() const noexcept { return !is_even(); }
+    void flip_sign() & noexcept { if (*this) mIsNegative = !mIsNegative; }
+    void set_positive() & noexcept { mIsNegative = false; }
+    void set_negative() & noexcept { if (*this) mIsNegative = true; }
+    void set_sign(bool negative) & noexcept { if (negative) set_negative(); else set_positive(); }
+
+    /// @brief sets value to zero (faster than *this = 0)
+    void zero() & noexcept
+    {
+        mIsNegative = false;
+        mNumbers.clear();
+        mNumbers.push_back(0);
+    }
+
+    /// @brief abs(*this) % divisor
+    ZXSHADY_NODISCARD std::uint64_t mod_small(std::uint64_t divisor) const;
+
+    binary_bigint& half() & noexcept { return div_2exp(1); }
+    binary_bigint  half() && noexcept { return this->half(); }
+
+    binary_bigint& double_() & { return mul_2exp(1); }
+    binary_bigint  double_() && { return this->double_(); }
+
+    /// @brief *this * 2^exponent
+    binary_bigint& mul_2exp(unsigned long long exponent) &;
+    binary_bigint  mul_2exp(unsigned long long exponent) && { return this->mul_2exp(exponent); }
+
+    /// @brief *this / 2^exponent rounded towards zero
+    binary_bigint& div_2exp(unsigned long long exponent) & noexcept;
+    binary_bigint  div_2exp(unsigned long long exponent) && noexcept { return this->div_2exp(exponent); }
+
+    ZXSHADY_NODISCARD bool is_pow_of_2() const noexcept;
+
+    /// @brief number of bits in abs(*this) without leading zeros, 0 for 0
+    ZXSHADY_NODISCARD std::size_t bit_length() const noexcept;
+
+    /// @brief bit `index` of *this in two's complement, negative numbers have infinitely many leading ones
+    ZXSHADY_NODISCARD bool test_bit(std::size_t index) const noexcept;
+
+    /// @brief sets bit `index` of the two's complement of *this to `value`
+    binary_bigint& set_bit(std::size_t index, bool value = true) &;
+
+    /// @brief number of set bits, the maximum of std::size_t for negative numbers (they have infinitely many)
+    ZXSHADY_NODISCARD std::size_t popcount() const noexcept;
+
+    /// @brief index of the lowest set bit (the same for x and -x), the maximum of std::size_t for 0
+    ZXSHADY_NODISCARD std::size_t count_trailing_zeros() const noexcept;
+
+    /// @note numbers longer than kDecimalThreshold bits are converted through bigint
+    std::string to_string() const;
+
+    /// @brief number of decimal digits of abs(*this), 1 for 0
+    std::size_t digit_count() const;
+
+    /// @brief bits taken by the limbs, bit_length() is the bit count of the value itself
+    std::size_t bit_count() const noexcept
+    {
+        return mNumbers.size() * kLimbBits;
+    }
+
+public: /******* FRIENDS AND STATICS ******/
+    friend std::ostream& operator<<(std::ostream& ostream, const binary_bigint& bignum);
+    friend std::istream& operator>>(std::istream& istream, binary_bigint& bignum);
+
+    static binary_bigint pow10(unsigned long long exponent);
+
+    /// @brief a / b and a % b from a single division
+    /// @return {quotient, remainder}, the quotient is rounded towards zero and the remainder has the sign of a
+    static std::pair<binary_bigint, binary_bigint> divmod(const binary_bigint& a, const binary_bigint& b);
+
+    /// @brief same as divmod(a, b) but writes into quotient and remainder
+    /// @note quotient and remainder may be a or b
+    static void divmod(const binary_bigint& a, const binary_bigint& b, binary_bigint& quotient, binary_bigint& remainder);
+
+    friend binary_bigint powmod(const binary_bigint& base, const binary_bigint& exponent, const binary_bigint& modulus);
+
+private:
+    // enough limbs for the magnitude of any integer up to 128 bits
+    constexpr static std::size_t kIntegerLimbs = 16 / sizeof(limb_type);
+
+    // writes abs(x) into out, returns the limb count (1 for 0)
+    template<typename Integer>
+    static std::size_t integer_limbs(Integer x, limb_type* out) noexcept
+    {
+        static_assert(sizeof(Integer) <= 16, "zxshady::binary_bigint integers wider than 128 bits are not supported");
+        auto magnitude = math::unsigned_abs<std::uint64_t>(x);
+        std::size_t size = 0;
+        do {
+            out[size++] = static_cast<limb_type>(magnitude);
+            // two half shifts, a single shift by the full width of a 64 bit magnitude is undefined
+            magnitude = magnitude >> (kLimbBits / 2) >> (kLimbBits / 2);
+        } while (magnitude != 0);
+        return size;
+    }
+
+    // parses the characters after the sign, with a 0x, 0b or 0o prefix if `prefix` is set
+    void parse(const char* str, std::size_t size, int base, bool prefix, char seperator);
+
+    // *this += (-1)^b_negative * b, b may point into *this
+    void add(const limb_type* b, std::size_t bsize, bool b_negative);
+    void multiply(const limb_type* b, std::size_t bsize, bool b_negative);
+    // *this = *this / b, or *this % b with `remainder` set
+    void divide(const limb_type* b, std::size_t bsize, bool b_negative, bool remainder);
+    ZXSHADY_NODISCARD int compare(const limb_type* b, std::size_t bsize, bool b_negative) const noexcept;
+
+    // the limbs of the two's complement, ~(abs(*this) - 1) for negative numbers, `size` limbs long
+    ZXSHADY_NODISCARD storage_type twos_complement(std::size_t size) const;
+    // inverse of twos_complement, the sign is the top bit of `limbs`
+    void assign_twos_complement(storage_type limbs);
+
+    void fix() noexcept
+    {
+        while (mNumbers.size() > 1 && mNumbers.back() == 0)
+            mNumbers.pop_back();
+
+        if (mNumbers.size() == 1 && mNumbers[0] == 0)
+            mIsNegative = false;
+
+        assert(!mNumbers.empty());
+    }
+
+    storage_type mNumbers;
+    bool mIsNegative;
+};
+
+inline bool is_negative(const binary_bigint& x) noexcept {
+    return x.is_negative();
+}
+
+inline bool is_positive(const binary_bigint& x) noexcept {
+    return x.is_positive();
+}
+
+ZXSHADY_DEFINE_COMPARISONS(const binary_bigint&, const binary_bigint&)
+
+ZXSHADY_DEFINE_ARITHMETIC(binary_bigint, const binary_bigint&)
+
+template<typename Integer,typename std::enable_if<std::is_integral<Integer>::value,int>::type = 0>
+ZXSHADY_NODISCARD binary_bigint operator+(binary_bigint a, Integer b)
+{
+    return a += b;
+}
+
+template<typename Integer,typename std::enable_if<std::is_integral<Integer>::value,int>::type = 0>
+ZXSHADY_NODISCARD binary_bigint operator+(Integer a, binary_bigint b)
+{
+    return b += a;
+}
+
+template<typename Integer,typename std::enable_if<std::is_integral<Integer>::value,int>::type = 0>
+ZXSHADY_NODISCARD binary_bigint operator-(binary_bigint a, Integer b)
+{
+    return a -= b;
+}
+
+template<typename Integer,typename std::enable_if<std::is_integral<Integer>::value,int>::type = 0>
+ZXSHADY_NODISCARD binary_bigint operator*(binary_bigint a, Integer b)
+{
+    return a *= b;
+}
+
+template<typename Integer,typename std::enable_if<std::is_integral<Integer>::value,int>::type = 0>
+ZXSHADY_NODISCARD binary_bigint operator*(Integer a, binary_bigint b)
+{
+    return b *= a;
+}
+
+template<typename Integer,typename std::enable_if<std::is_integral<Integer>::value,int>::type = 0>
+ZXSHADY_NODISCARD binary_bigint operator/(binary_bigint a, Integer b)
+{
+    return a /= b;
+}
+
+template<typename Integer,typename std::enable_if<std::is_integral<Integer>::value,int>::type = 0>
+ZXSHADY_NODISCARD binary_bigint operator%(binary_bigint a, Integer b)
+{
+    return a %= b;
+}
+
+ZXSHADY_NODISCARD inline binary_bigint operator&(binary_bigint a, const binary_bigint& b) { return a &= b; }
+ZXSHADY_NODISCARD inline binary_bigint operator|(binary_bigint a, const binary_bigint& b) { return a |= b; }
+ZXSHADY_NODISCARD inline binary_bigint operator^(binary_bigint a, const binary_bigint& b) { return a ^= b; }
+ZXSHADY_NODISCARD inline binary_bigint operator<<(binary_bigint a, unsigned long long bits) { return a <<= bits; }
+ZXSHADY_NODISCARD inline binary_bigint operator>>(binary_bigint a, unsigned long long bits) { return a >>= bits; }
+
+template<typename Integer,typename std::enable_if<std::is_integral<Integer>::value,int>::type = 0>
+ZXSHADY_NODISCARD binary_bigint operator&(binary_bigint a, Integer b)
+{
+    return a &= b;
+}
+
+template<typename Integer,typename std::enable_if<std::is_integral<Integer>::value,int>::type = 0>
+ZXSHADY_NODISCARD binary_bigint operator&(Integer a, binary_bigint b)
+{
+    return b &= a;
+}
+
+template<typename Integer,typename std::enable_if<std::is_integral<Integer>::value,int>::type = 0>
+ZXSHADY_NODISCARD binary_bigint operator|(binary_bigint a, Integer b)
+{
+    return a |= b;
+}
+
+template<typename Integer,typename std::enable_if<std::is_integral<Integer>::value,int>::type = 0>
+ZXSHADY_NODISCARD binary_bigint operator|(Integer a, binary_bigint b)
+{
+    return b |= a;
+}
+
+template<typename Integer,typename std::enable_if<std::is_integral<Integer>::value,int>::type = 0>
+ZXSHADY_NODISCARD binary_bigint operator^(binary_bigint a, Integer b)
+{
+    return a ^= b;
+}
+
+template<typename Integer,typename std::enable_if<std::is_integral<Integer>::value,int>::type = 0>
+ZXSHADY_NODISCARD binary_bigint operator^(Integer a, binary_bigint b)
+{
+    return b ^= a;
+}
+
+template<typename Integer,typename std::enable_if<std::is_integral<Integer>::value,int>::type = 0 > ZXSHADY_NODISCARD bool operator!=(Integer a, const binary_bigint& b) noexcept { return !(a == b); }
+template<typename Integer,typename std::enable_if<std::is_integral<Integer>::value,int>::type = 0 > ZXSHADY_NODISCARD bool operator!=(const binary_bigint& a, Integer b) noexcept { return !(a == b); }
+
+template<typename Integer,typename std::enable_if<std::is_integral<Integer>::value,int>::type = 0 >
+ZXSHADY_NODISCARD bool operator>(const binary_bigint& a,Integer b) noexcept
+{
+    return b < a;
+}
+
+template<typename Integer,typename std::enable_if<std::is_integral<Integer>::value,int>::type = 0 >
+ZXSHADY_NODISCARD bool operator<=(const binary_bigint& a,Integer b) noexcept
+{
+    return !(a > b);
+}
+
+template<typename Integer,typename std::enable_if<std::is_integral<Integer>::value,int>::type = 0 >
+ZXSHADY_NODISCARD bool operator>=(const binary_bigint& a,Integer b) noexcept
+{
+    return !(a < b);
+}
+
+template<typename Integer,typename std::enable_if<std::is_integral<Integer>::value,int>::type = 0 >
+ZXSHADY_NODISCARD bool operator>(Integer a,const binary_bigint& b) noexcept
+{
+    return b < a;
+}
+
+template<typename Integer,typename std::enable_if<std::is_integral<Integer>::value,int>::type = 0 >
+ZXSHADY_NODISCARD bool operator<=(Integer a,const binary_bigint& b) noexcept
+{
+    return !(a > b);
+}
+
+template<typename Integer,typename std::enable_if<std::is_integral<Integer>::value,int>::type = 0 >
+ZXSHADY_NODISCARD bool operator>=(Integer a,const binary_bigint& b) noexcept
+{
+    return !(a < b);
+}
+
+inline void swap(binary_bigint& a, binary_bigint& b) noexcept
+{
+    a.swap(b);
+}
+
+ZXSHADY_NODISCARD inline binary_bigint operator+(binary_bigint x)
+{return x;};
+
+ZXSHADY_NODISCARD inline binary_bigint operator-(binary_bigint x)
+{x.flip_sign();return x;};
+
+/// @brief bitwise not, -x - 1 in two's complement
+ZXSHADY_NODISCARD inline binary_bigint operator~(binary_bigint x)
+{x.flip_sign();--x;return x;};
+
+inline binary_bigint abs(binary_bigint x)
+{
+    x.set_positive();
+    return x;
+}
+
+std::ostream& operator<<(std::ostream& ostream, const binary_bigint& bignum);
+std::istream& operator>>(std::istream& istream, binary_bigint& bignum);
+
+unsigned long long log2(const binary_bigint& x);
+binary_bigint pow(binary_bigint base, unsigned long long exponent);
+/// @brief base^exponent % modulus in [0, modulus), montgomery multiplication for odd moduli
+binary_bigint powmod(const binary_bigint& base, const binary_bigint& exponent, const binary_bigint& modulus);
+binary_bigint sqrt(const binary_bigint& x);
+binary_bigint gcd(binary_bigint a, binary_bigint b);
+binary_bigint lcm(const binary_bigint& a, const binary_bigint& b);
+
+}
+
+#endif // !ZXSHADY_BINARY_BIGINT_HPP
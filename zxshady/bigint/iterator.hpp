@@ -23,7 +23,7 @@ public:
     constexpr iterator(T* ptr, int place) noexcept : m_ptr(ptr), m_place(place) {}
 
     constexpr iterator(const iterator&) noexcept = default;
-    constexpr iterator& operator=(const iterator&) &noexcept = default;
+    iterator& operator=(const iterator&) &noexcept = default;
 
 
     iterator& operator++() & noexcept
@@ -14,6 +14,7 @@
 #include <cassert>
 #include <numeric>
 #include <iostream>
+#include <sstream>
 
 
 
@@ -27,6 +28,39 @@
 #define CHECK(x) 
 
 #endif
+
+// counts the limbs allocated through it, copies share the counter and a default
+// constructed one counts into stray_allocations
+template<typename T>
+struct counting_allocator {
+    using value_type = T;
+
+    static std::size_t stray_allocations;
+    std::size_t* count = nullptr;
+
+    counting_allocator() = default;
+    explicit counting_allocator(std::size_t* counter) noexcept : count(counter) {}
+    template<typename U>
+    counting_allocator(const counting_allocator<U>& other) noexcept : count(other.count) {}
+
+    T* allocate(std::size_t n)
+    {
+        *(count ? count : &stray_allocations) += n;
+        return std::allocator<T>().allocate(n);
+    }
+
+    void deallocate(T* p, std::size_t n) noexcept
+    {
+        std::allocator<T>().deallocate(p, n);
+    }
+
+    friend bool operator==(const counting_allocator& a, const counting_allocator& b) noexcept { return a.count == b.count; }
+    friend bool operator!=(const counting_allocator& a, const counting_allocator& b) noexcept { return a.count != b.count; }
+};
+
+template<typename T>
+std::size_t counting_allocator<T>::stray_allocations = 0;
+
 void bigint_test()
 {
     using namespace zxshady;
@@ -272,6 +306,30 @@ void bigint_test()
         REQUIRE(b-a == 0xff - 12);
 
         REQUIRE(a-b == 12 - 0xff);
+
+        // comparisons against builtin integers work in the integer's own width
+        const bigint max64 = 18446744073709551615ULL;
+        REQUIRE(max64 == 18446744073709551615ULL);
+        REQUIRE(!(max64 < 18446744073709551615ULL));
+        REQUIRE(max64 - 1 < 18446744073709551615ULL);
+        REQUIRE(max64 + 1 > 18446744073709551615ULL);
+        REQUIRE(-max64 < -9223372036854775807LL);
+#if defined(ZXSHADY_BIGINT_HAS_INT128) && !defined(__STRICT_ANSI__)
+        // builtin 128 bit integers only count as integral outside of strict iso mode
+        const __int128 big = static_cast<__int128>(1000000000000000ULL) * 1000000000000000ULL; // 10^30
+        const bigint bigger = bigint::pow10(30);
+        REQUIRE(bigger == big);
+        REQUIRE(!(bigger < big));
+        REQUIRE(!(bigger > big));
+        REQUIRE(bigger - 1 < big);
+        REQUIRE(bigger + 1 > big);
+        REQUIRE(-bigger == -big);
+        REQUIRE(-bigger - 1 < -big);
+        const unsigned __int128 umax = ~static_cast<unsigned __int128>(0);
+        REQUIRE(bigint(umax) == umax);
+        REQUIRE(bigint(umax) - 1 < umax);
+        REQUIRE(bigint(umax) + 1 > umax);
+#endif
     }
 
     TEST_CASE("Base cases for pow()", "[functions][math][pow]")
@@ -651,4 +709,644 @@ void bigint_test()
             "533220692127153044311875258011747917053108027629278373174251200266431"
             "428784066739966");
     }
+
+    TEST_CASE("multiplication of big integers", "[functions][math][mul][big]")
+    {
+        // (10^n - 1)^2 == 10^2n - 2 * 10^n + 1
+        for (unsigned long long n : { 100ULL, 1000ULL, 12345ULL, 50000ULL }) {
+            const bigint nines = bigint::pow10(n) - 1;
+            REQUIRE(nines * nines == bigint::pow10(2 * n) - bigint::pow10(n) * 2 + 1);
+        }
+
+        // unbalanced operands
+        const bigint a = bigint::rand(40000);
+        const bigint b = bigint::rand(3000);
+        const bigint c = bigint::rand(3000);
+        REQUIRE(a * (b + c) == a * b + a * c);
+        REQUIRE(a * b == b * a);
+
+        // sizes that go through the toom splits
+        for (std::size_t digits : { 5000, 15000, 25000 }) {
+            const bigint x = bigint::rand(digits);
+            const bigint y = bigint::rand(digits * 2 / 3);
+            const bigint z = bigint::rand(digits / 3);
+            REQUIRE((x * y) * z == x * (y * z));
+            REQUIRE(x * (y + z) == x * y + x * z);
+            REQUIRE((x - 1) * (x + 1) == x * x - 1);
+        }
+
+        // ntt sized, checked against the karatsuba identity on its halves
+        const bigint high = bigint::rand(100000);
+        const bigint low = bigint::rand(100000);
+        const bigint shift = bigint::pow10(100000);
+        const bigint x = high * shift + low;
+        REQUIRE(x * x == high * high * shift * shift + high * low * 2 * shift + low * low);
+    }
+
+    TEST_CASE("squaring", "[functions][math][mul][sqr]")
+    {
+        for (std::size_t digits : { 10, 500, 5000, 30000 }) {
+            const bigint a = bigint::rand(digits);
+            const bigint b = bigint::rand(digits);
+            bigint square = a;
+            square *= square;
+            REQUIRE(square == a * (a + 1) - a);
+            REQUIRE(a * -a == -square);
+            REQUIRE((a * b) * (a * b) == square * (b * b));
+        }
+        REQUIRE(pow(bigint(-3), 5) == -243);
+        REQUIRE(pow(bigint(2), 64) == "18446744073709551616");
+    }
+
+    TEST_CASE("division of big integers", "[functions][math][div][big]")
+    {
+        for (std::size_t digits : { 10, 100, 1000, 10000, 60000 }) {
+            const bigint a = abs(bigint::rand(digits));
+            const bigint b = abs(bigint::rand(digits / 2 + 1)) + 1;
+            const bigint r = abs(bigint::rand(digits / 4 + 1)) % b;
+            REQUIRE((a * b) / b == a);
+            REQUIRE((a * b + r) / b == a);
+            REQUIRE((a * b + r) % b == r);
+            REQUIRE((-(a * b) - r) / b == -a);
+            REQUIRE((-(a * b) - r) % b == -r);
+        }
+        REQUIRE(bigint("1000000000000000000000000000") / bigint("999999999") == "1000000001000000001");
+        REQUIRE(bigint("1000000000000000000000000000") % bigint("999999999") == 1);
+        REQUIRE(!(bigint(-6) % 3).is_negative());
+
+        for (const char* dividend : { "-1000000000000000000000000000007", "1000000000000000000000000000007", "5", "-5" }) {
+            for (const char* divisor : { "-999999999", "999999999", "7", "-7" }) {
+                const auto qr = bigint::divmod(bigint(dividend), bigint(divisor));
+                REQUIRE(qr.first == bigint(dividend) / bigint(divisor));
+                REQUIRE(qr.second == bigint(dividend) % bigint(divisor));
+            }
+        }
+        const bigint a = bigint::rand(500);
+        const bigint b = bigint::rand(200);
+        bigint q = a;
+        bigint r = b;
+        bigint::divmod(q, r, q, r);
+        REQUIRE(q == a / b);
+        REQUIRE(r == a % b);
+
+        // dividend much longer than the divisor goes through several recursive blocks
+        const bigint big = abs(bigint::rand(40000));
+        const bigint divisor = abs(bigint::rand(3000)) + 1;
+        const bigint quotient = big / divisor;
+        const bigint remainder = big % divisor;
+        REQUIRE(quotient * divisor + remainder == big);
+        REQUIRE(remainder < divisor);
+    }
+
+    TEST_CASE("reciprocal", "[functions][math][div][reciprocal]")
+    {
+        REQUIRE(bigint(3).reciprocal(10) == 3333333333);
+        REQUIRE(bigint(-7).reciprocal(3) == -142);
+        REQUIRE(bigint(100).reciprocal(2) == 1);
+        REQUIRE(bigint(1000).reciprocal(2) == 0);
+
+        const bigint divisor = abs(bigint::rand(2000)) + 1;
+        const bigint reciprocal = divisor.reciprocal(5000);
+        REQUIRE(reciprocal == bigint::pow10(5000) / divisor);
+        for (std::size_t digits : { 1, 1500, 2000, 4000, 5000 }) {
+            const bigint a = bigint::rand(digits);
+            REQUIRE(bigint::div_by_reciprocal(a, divisor, reciprocal, 5000) == a / divisor);
+            REQUIRE(bigint::div_by_reciprocal(a, -divisor, -reciprocal, 5000) == a / -divisor);
+        }
+
+        // big enough for bigint::div to divide through the reciprocal itself
+        const bigint a = abs(bigint::rand(150000));
+        const bigint b = abs(bigint::rand(75000)) + 1;
+        const bigint q = a / b;
+        const bigint r = a % b;
+        REQUIRE(q * b + r == a);
+        REQUIRE(!r.is_negative());
+        REQUIRE(r < b);
+    }
+
+    TEST_CASE("division by machine words", "[functions][math][div][small]")
+    {
+        const bigint a = bigint("123456789012345678901234567890123456789");
+        REQUIRE(a / 7 == bigint("17636684144620811271604938270017636684"));
+        REQUIRE(a % 7 == 1);
+        REQUIRE(-a % 7 == -1);
+        REQUIRE(a % -7 == 1);
+        REQUIRE(a / 10000000000ULL == bigint("12345678901234567890123456789"));
+        REQUIRE(a % 10000000000ULL == 123456789);
+        REQUIRE(a / 18446744073709551615ULL == bigint("6692605942763486918"));
+        REQUIRE(a % 18446744073709551615ULL == 558601170425184219ULL);
+        REQUIRE(a.mod_small(7) == 1);
+        REQUIRE((-a).mod_small(7) == 1);
+        REQUIRE(a.mod_small(18446744073709551615ULL) == 558601170425184219ULL);
+        REQUIRE(bigint().mod_small(3) == 0);
+
+        std::ostringstream hex;
+        hex << std::hex << a << ' ' << bigint(0) << ' ' << bigint(4294967296);
+        REQUIRE(hex.str() == "5ce0e9a56015fec5aadfa328ae398115 0 100000000");
+        std::ostringstream oct;
+        oct << std::oct << a << ' ' << bigint(0) << ' ' << bigint(8589934592);
+        REQUIRE(oct.str() == "1347016464530012776613253375062425616300425 0 100000000000");
+    }
+
+    TEST_CASE("power of two shifts", "[functions][math][half][2exp]")
+    {
+        REQUIRE(bigint(7).half() == 3);
+        REQUIRE(bigint(-7).half() == -3);
+        REQUIRE(bigint(1).half() == 0);
+        REQUIRE(!bigint(-1).half().is_negative());
+        REQUIRE(bigint("2000000000000000000").half() == bigint("1000000000000000000"));
+
+        for (unsigned long long bits : { 0, 1, 29, 33, 34, 64, 1000 }) {
+            const bigint a = bigint::rand(500);
+            bigint shifted = a;
+            shifted.mul_2exp(bits);
+            REQUIRE(shifted == a * pow(bigint(2), bits));
+            REQUIRE(shifted.div_2exp(bits) == a);
+            REQUIRE(bigint(a).div_2exp(bits) == a / pow(bigint(2), bits));
+        }
+        REQUIRE(bigint(12345).div_2exp(100000) == 0);
+
+        const bigint power = pow(bigint(2), 3000);
+        REQUIRE(log2(power) == 3000);
+        REQUIRE(log2(power - 1) == 2999);
+        REQUIRE(power.is_pow_of_2());
+        REQUIRE(!(power + 2).is_pow_of_2());
+    }
+
+    TEST_CASE("pow() windows and short cuts", "[functions][math][pow]")
+    {
+        REQUIRE(pow(bigint(-1), 1000001) == -1);
+        REQUIRE(pow(bigint(-100), 3) == -1000000);
+        REQUIRE(pow(bigint(1000000000), 2) == bigint::pow10(18));
+        REQUIRE(pow(bigint(-8), 7) == -2097152);
+        REQUIRE(pow(bigint(1024), 100) == pow(bigint(2), 1000));
+        REQUIRE(pow(bigint(2), 100) == bigint("1267650600228229401496703205376"));
+
+        const bigint base = bigint::rand(50);
+        for (unsigned long long exponent : { 2, 3, 255, 256, 1000, 12345 }) {
+            bigint expected = pow(base, exponent / 2);
+            expected *= expected;
+            if (exponent % 2 == 1)
+                expected *= base;
+            REQUIRE(pow(base, exponent) == expected);
+        }
+    }
+
+    TEST_CASE("powmod()", "[functions][math][powmod]")
+    {
+        REQUIRE(powmod(bigint(4), bigint(13), bigint(497)) == 445);
+        REQUIRE(powmod(bigint(-2), bigint(3), bigint(5)) == 2);
+        REQUIRE(powmod(bigint(7), bigint(0), bigint(13)) == 1);
+        REQUIRE(powmod(bigint(7), bigint(0), bigint(1)) == 0);
+        REQUIRE(powmod(bigint(2), bigint::pow10(20), bigint(1000000007)) == 855473248);
+        REQUIRE(powmod(bigint(3), bigint(200), bigint("18446744073709551616")) == bigint("6627890308811632801"));
+        REQUIRE(powmod(bigint(123456789), bigint("987654321987654321"), bigint::pow10(30) + 1) == bigint("549097123961326923806812982240"));
+        bool threw = false;
+        try {
+            bigint::montgomery_context even(bigint(1000));
+        }
+        catch (std::invalid_argument&) {
+            threw = true;
+        }
+        REQUIRE(threw);
+
+        // fermat's little theorem with one context for many bases
+        const bigint prime = pow(bigint(2), 127) - 1;
+        const bigint::montgomery_context context(prime);
+        for (int i = 0; i < 5; ++i) {
+            const bigint base = abs(bigint::rand(30)) + 1;
+            REQUIRE(powmod(base, prime - 1, context) == 1);
+            REQUIRE(powmod(base, prime, context) == base);
+        }
+
+        // moduli on both sides of the reduction threshold and ones without a montgomery form
+        for (std::size_t digits : { 20, 500, 2000 }) {
+            const bigint modulus = abs(bigint::rand(digits)) * 10 + 3;
+            const bigint base = abs(bigint::rand(digits + 5));
+            const bigint expected = base * base % modulus * base % modulus;
+            REQUIRE(powmod(base, bigint(3), modulus) == expected);
+            REQUIRE(powmod(base, bigint(3), modulus * 2) == base * base % (modulus * 2) * base % (modulus * 2));
+        }
+    }
+
+    TEST_CASE("barrett_reducer", "[functions][math][mod][barrett]")
+    {
+        const bigint::barrett_reducer seven(bigint(-7));
+        REQUIRE(seven(bigint(100)) == 2);
+        REQUIRE(seven(bigint(-100)) == -2);
+        REQUIRE(seven(bigint(6)) == 6);
+        REQUIRE(seven(bigint(0)) == 0);
+
+        // powers of 7 and 3 are nowhere near round numbers in base 10^9
+        for (unsigned long long digits : { 9, 18, 99, 999 }) {
+            const bigint modulus = pow(bigint(7), digits * 118 / 100) + 12345;
+            const bigint::barrett_reducer reducer(modulus);
+            bigint::barrett_reducer::scratch buffers;
+            for (unsigned long long size : { digits / 2 + 1, digits, 2 * digits, 5 * digits + 3 }) {
+                const bigint value = -pow(bigint(3), size * 209 / 100) - 1;
+                bigint reduced = value;
+                reducer.reduce(reduced, buffers);
+                REQUIRE(reduced == value % modulus);
+            }
+            bigint square = modulus * modulus - 1;
+            reducer.reduce(square, buffers);
+            REQUIRE(square == modulus - 1);
+        }
+    }
+
+    TEST_CASE("fac()", "[functions][math][fac]")
+    {
+        REQUIRE(fac(bigint(0)) == 1);
+        REQUIRE(fac(bigint(1)) == 1);
+        REQUIRE(fac(bigint(20)) == bigint("2432902008176640000"));
+        REQUIRE(fac(bigint(25)) == bigint("15511210043330985984000000"));
+
+        bigint expected = 1;
+        for (int i = 2; i <= 3000; ++i) {
+            expected *= i;
+            if (i % 499 == 0 || i == 3000)
+                REQUIRE(fac(bigint(i)) == expected);
+        }
+    }
+
+    TEST_CASE("binomial() and falling/rising factorials", "[functions][math][binomial]")
+    {
+        REQUIRE(binomial(bigint(100), bigint(50)) == bigint("100891344545564193334812497256"));
+        REQUIRE(binomial(bigint::pow10(25), bigint(3)) == bigint("166666666666666666666666616666666666666666666666670000000000000000000000000"));
+        REQUIRE(binomial(bigint(5), bigint(0)) == 1);
+        REQUIRE(binomial(bigint(5), bigint(6)) == 0);
+        REQUIRE(binomial(bigint(5), bigint(-1)) == 0);
+        REQUIRE(binomial(bigint(-4), bigint(3)) == -20);
+
+        // the sieve and the division paths against each other and against the factorials
+        REQUIRE(binomial(bigint(2000), bigint(700)) == fac(bigint(2000)) / (fac(bigint(700)) * fac(bigint(1300))));
+        REQUIRE(binomial(bigint(100000), bigint(10)) == falling_factorial(bigint(100000), 10) / fac(bigint(10)));
+        bigint row = 1;
+        for (int k = 1; k <= 300; ++k) {
+            row = row * (300 - k + 1) / k;
+            REQUIRE(binomial(bigint(300), bigint(k)) == row);
+        }
+
+        REQUIRE(falling_factorial(bigint(10), 3) == 720);
+        REQUIRE(falling_factorial(bigint(3), 5) == 0);
+        REQUIRE(falling_factorial(bigint(-3), 3) == -60);
+        REQUIRE(rising_factorial(bigint(3), 4) == 360);
+        REQUIRE(rising_factorial(bigint(-2), 3) == 0);
+        REQUIRE(rising_factorial(bigint(-5), 3) == -60);
+        REQUIRE(rising_factorial(bigint(1), 500) == fac(bigint(500)));
+        REQUIRE(falling_factorial(bigint(7), 0) == 1);
+
+        const bigint big = pow(bigint(10), 30) + 7;
+        REQUIRE(falling_factorial(big, 3) == big * (big - 1) * (big - 2));
+        REQUIRE(rising_factorial(big, 3) == big * (big + 1) * (big + 2));
+    }
+
+    TEST_CASE("sqrtrem()", "[functions][math][sqrt][sqrtrem]")
+    {
+        REQUIRE(sqrtrem(bigint(0)) == std::make_pair(bigint(0), bigint(0)));
+        REQUIRE(sqrtrem(bigint(15)) == std::make_pair(bigint(3), bigint(6)));
+        REQUIRE(sqrtrem(bigint::pow10(18)) == std::make_pair(bigint::pow10(9), bigint(0)));
+        REQUIRE(sqrtrem(bigint::pow10(45) - 1).first == bigint("31622776601683793319988"));
+
+        for (unsigned long long digits : { 10, 90, 1000, 20000 }) {
+            const bigint root = pow(bigint(7), digits) + 3;
+            for (const bigint& offset : { bigint(0), bigint(1), root * 2 }) {
+                const auto result = sqrtrem(root * root + offset);
+                REQUIRE(result.first == root);
+                REQUIRE(result.second == offset);
+            }
+            REQUIRE(sqrt(root * root - 1) == root - 1);
+        }
+    }
+
+    TEST_CASE("iroot() and perfect powers", "[functions][math][iroot][perfect]")
+    {
+        REQUIRE(iroot(bigint(26), 3) == 2);
+        REQUIRE(iroot(bigint(27), 3) == 3);
+        REQUIRE(iroot(bigint(-27), 3) == -3);
+        REQUIRE(iroot(bigint(12345), 1) == 12345);
+        REQUIRE(iroot(bigint(0), 5) == 0);
+        REQUIRE(iroot(bigint(1000), 100) == 1);
+        REQUIRE(iroot(bigint::pow10(1000), 1000) == 10);
+
+        for (unsigned long long n : { 3, 4, 7, 30 }) {
+            const bigint root = pow(bigint(7), 500 / n) + 3;
+            REQUIRE(iroot(pow(root, n), n) == root);
+            REQUIRE(iroot(pow(root, n) - 1, n) == root - 1);
+            REQUIRE(iroot(pow(root + 1, n) - 1, n) == root);
+        }
+
+        REQUIRE(bigint(0).is_perfect_square());
+        REQUIRE(bigint(1).is_perfect_square());
+        REQUIRE(!bigint(-4).is_perfect_square());
+        REQUIRE(!bigint(2).is_perfect_square());
+        REQUIRE(pow(bigint(12345678910), 2).is_perfect_square());
+        REQUIRE(!(pow(bigint(12345678910), 2) + 1).is_perfect_square());
+
+        REQUIRE(bigint(-1).is_perfect_power());
+        REQUIRE(bigint(8).is_perfect_power());
+        REQUIRE(bigint(-8).is_perfect_power());
+        REQUIRE(!bigint(-4).is_perfect_power());
+        REQUIRE(!bigint(12).is_perfect_power());
+        REQUIRE(pow(bigint(3), 1001).is_perfect_power());
+        REQUIRE(pow(bigint(-12345), 37).is_perfect_power());
+        REQUIRE(pow(bigint("1000000000039"), 7).is_perfect_power());
+        REQUIRE(!(pow(bigint("1000000000039"), 7) + 2).is_perfect_power());
+        REQUIRE(!(pow(bigint(7), 2000) + 2).is_perfect_power());
+    }
+    TEST_CASE("xgcd() and invmod()", "[functions][math][gcd][xgcd][invmod]")
+    {
+        const bigint common = pow(bigint(3), 300);
+        const bigint a = common * (pow(bigint(7), 600) + 2);
+        const bigint b = common * (pow(bigint(11), 500) + 4);
+        REQUIRE(gcd(a, b) % common == 0);
+        REQUIRE(gcd(a, -b) == gcd(b, a));
+
+        for (const bigint& x : { a, -a, bigint(0), bigint(12) }) {
+            for (const bigint& y : { b, -b, bigint(0), bigint(-18) }) {
+                const auto result = xgcd(x, y);
+                REQUIRE(std::get<0>(result) == gcd(x, y));
+                REQUIRE(x * std::get<1>(result) + y * std::get<2>(result) == std::get<0>(result));
+            }
+        }
+
+        const bigint m = pow(bigint(2), 1279) - 1;
+        for (const bigint& x : { a, -b, bigint(1), bigint(2) }) {
+            const bigint inverse = invmod(x, m);
+            REQUIRE(inverse >= 0);
+            REQUIRE(inverse < m);
+            REQUIRE((x * inverse - 1) % m == 0);
+        }
+        REQUIRE(invmod(bigint(5), bigint(1)) == 0);
+
+        bool threw = false;
+        try {
+            (void)invmod(a, b);
+        }
+        catch (const std::domain_error&) {
+            threw = true;
+        }
+        REQUIRE(threw);
+    }
+    TEST_CASE("is_prime()", "[functions][math][prime]")
+    {
+        std::vector<bool> composite(3000);
+        for (int i = 2; i < 3000; ++i) {
+            for (int j = 2 * i; j < 3000; j += i)
+                composite[j] = true;
+            REQUIRE(bigint(i).is_prime() == !composite[i]);
+        }
+        REQUIRE(!bigint(0).is_prime());
+        REQUIRE(!bigint(1).is_prime());
+        REQUIRE(!bigint(-7).is_prime());
+
+        // carmichael numbers and strong pseudoprimes to the first bases
+        for (const char* value : { "561", "41041", "2047", "3215031751", "2152302898747", "3825123056546413051", "318665857834031151167461" })
+            REQUIRE(!bigint(value).is_prime());
+        REQUIRE(bigint("18446744073709551557").is_prime());
+        REQUIRE(!bigint("18446744073709551617").is_prime());
+
+        const bigint m521 = pow(bigint(2), 521) - 1;
+        const bigint m607 = pow(bigint(2), 607) - 1;
+        REQUIRE(m521.is_prime());
+        REQUIRE((bigint::pow10(100) + 267).is_prime());
+        REQUIRE(!(m521 * m607).is_prime());
+        REQUIRE(!(m521 + 2).is_prime());
+
+        std::mt19937_64 random(12345);
+        REQUIRE(m607.is_prime(10, random));
+        REQUIRE(!(m521 * m607).is_prime(10, random));
+        REQUIRE(bigint(1000003).is_prime(0, random));
+        REQUIRE(!bigint("3825123056546413051").is_prime(0, random));
+    }
+    TEST_CASE("bit_length() and log2()", "[functions][math][log2][bits]")
+    {
+        REQUIRE(bigint(0).bit_length() == 0);
+        REQUIRE(bigint(1).bit_length() == 1);
+        REQUIRE(bigint(-255).bit_length() == 8);
+        REQUIRE(bigint(256).bit_length() == 9);
+        REQUIRE(bigint("18446744073709551615").bit_length() == 64);
+        REQUIRE(bigint("18446744073709551616").bit_length() == 65);
+
+        for (unsigned long long k : { 60, 64, 100, 1000, 29897, 100000 }) {
+            const bigint power = pow(bigint(2), k);
+            REQUIRE(power.bit_length() == k + 1);
+            REQUIRE((power - 1).bit_length() == k);
+            REQUIRE((power + 1).bit_length() == k + 1);
+            REQUIRE(log2(power) == k);
+            REQUIRE(log2(power - 1) == k - 1);
+            REQUIRE(power.is_pow_of_2());
+            REQUIRE(!(power + 2).is_pow_of_2());
+            REQUIRE(!(power - 2).is_pow_of_2());
+            REQUIRE(!(power * 3).is_pow_of_2());
+        }
+        REQUIRE(log2(bigint::pow10(1000)) == 3321);
+        REQUIRE(!bigint(-8).is_pow_of_2());
+    }
+    TEST_CASE("bitwise operators and shifts", "[functions][operators][bitwise]")
+    {
+        REQUIRE((bigint(12) & bigint(10)) == 8);
+        REQUIRE((bigint(12) | bigint(10)) == 14);
+        REQUIRE((bigint(12) ^ bigint(10)) == 6);
+        REQUIRE((bigint(-12) & bigint(10)) == 0);
+        REQUIRE((bigint(-12) | bigint(10)) == -2);
+        REQUIRE((bigint(-12) ^ bigint(-10)) == 2);
+        REQUIRE(~bigint(0) == -1);
+        REQUIRE(~bigint(-5) == 4);
+
+        REQUIRE((bigint(-12) & 10) == 0);
+        REQUIRE((10 | bigint(-12)) == -2);
+        REQUIRE((bigint(-12) ^ -10) == 2);
+        REQUIRE((bigint("-18446744073709551616") | 5u) == bigint("-18446744073709551611"));
+
+        // every bit of 2^k - 1 is set, 2^k has a single one above them
+        const bigint power = pow(bigint(2), 5000);
+        REQUIRE(((power - 1) & power) == 0);
+        REQUIRE(((power - 1) | power) == 2 * power - 1);
+        REQUIRE(((power - 1) ^ (power + 1)) == 2 * power - 2);
+        REQUIRE((-power & (power - 1)) == 0);
+        REQUIRE((-power | (power - 1)) == -1);
+        REQUIRE(((power + 12345) & 0xFFFF) == 12345);
+        REQUIRE(((-power - 1) & bigint(power + 7)) == 7);
+
+        REQUIRE((bigint(1) << 5000) == power);
+        REQUIRE((power >> 4990) == 1024);
+        REQUIRE((bigint(-7) >> 1) == -4);
+        REQUIRE((-power >> 5001) == -1);
+        REQUIRE(((-power - 1) >> 5000) == -2);
+
+        REQUIRE(power.test_bit(5000));
+        REQUIRE(!power.test_bit(4999));
+        REQUIRE(!(power - 1).test_bit(5000));
+        REQUIRE((power - 1).test_bit(4999));
+        REQUIRE((-power).test_bit(5000));
+        REQUIRE((-power).test_bit(100000));
+        REQUIRE(!(-power).test_bit(4999));
+        REQUIRE(bigint(-1).test_bit(3));
+        REQUIRE(!bigint(6).test_bit(0));
+
+        bigint x = 5;
+        x.set_bit(1);
+        REQUIRE(x == 7);
+        x.set_bit(0, false).set_bit(6000);
+        REQUIRE(x == bigint(1).mul_2exp(6000) + 6);
+        bigint y = -1;
+        y.set_bit(70, false);
+        REQUIRE(y == -1 - pow(bigint(2), 70));
+
+        REQUIRE(bigint(0).popcount() == 0);
+        REQUIRE(bigint(255).popcount() == 8);
+        REQUIRE((power - 1).popcount() == 5000);
+        REQUIRE(bigint(-1).popcount() == (std::numeric_limits<std::size_t>::max)());
+
+        REQUIRE(bigint(0).count_trailing_zeros() == (std::numeric_limits<std::size_t>::max)());
+        REQUIRE(bigint(40).count_trailing_zeros() == 3);
+        REQUIRE(bigint(-40).count_trailing_zeros() == 3);
+        REQUIRE(power.count_trailing_zeros() == 5000);
+        REQUIRE((power * 3).count_trailing_zeros() == 5000);
+        REQUIRE(bigint::pow10(100).count_trailing_zeros() == 100);
+    }
+    TEST_CASE("limb boundaries", "[functions][math][limbs]")
+    {
+        // 10^9 and 10^18 are the limb sizes with ZXSHADY_BIGINT_LIMB_BITS 32 and 64
+        const bigint nine = 999999999;
+        const bigint eighteen = bigint("999999999999999999");
+        REQUIRE(nine + 1 == 1000000000);
+        REQUIRE(eighteen + 1 == bigint::pow10(18));
+        REQUIRE(bigint::pow10(18) - 1 == eighteen);
+        REQUIRE(eighteen * eighteen == bigint("999999999999999998000000000000000001"));
+        REQUIRE(eighteen * eighteen / eighteen == eighteen);
+        REQUIRE(eighteen * 999999999999999999ULL == eighteen * eighteen);
+        REQUIRE((eighteen * eighteen + eighteen) % eighteen == 0);
+        REQUIRE(bigint(18446744073709551615ULL).to<std::uint64_t>() == 18446744073709551615ULL);
+        REQUIRE(bigint("123456789012345678901234567890").to_string() == "123456789012345678901234567890");
+        REQUIRE(bigint("100000000000000000000000000000000000") == bigint::pow10(35));
+
+        const bigint big = pow(eighteen, 40) + 12345;
+        REQUIRE(big.mod_small(1000000007) == (pow(eighteen, 40) % 1000000007 + 12345) % 1000000007);
+        REQUIRE(gcd(big * eighteen, eighteen * eighteen) == eighteen * gcd(big, eighteen));
+        REQUIRE(sqrt(big * big) == big);
+        REQUIRE(sqrt(bigint("24465964562071830625")) == 4946308175);
+        REQUIRE(bigint(1).mul_2exp(100).is_pow_of_2());
+        REQUIRE(bigint(1).mul_2exp(100).bit_length() == 101);
+        REQUIRE((bigint(1).mul_2exp(130) >> 70) == bigint(1).mul_2exp(60));
+    }
+    TEST_CASE("basic_bigint with other radices", "[functions][math][basic_bigint]")
+    {
+        // every configuration has to agree with bigint digit for digit
+        using radix_10000 = basic_bigint<std::uint32_t, 10000u>;
+        const bigint a = pow(bigint(3), 700) - 7;
+        const bigint b = pow(bigint(7), 180) + 1;
+        const radix_10000 x(a.to_string());
+        const radix_10000 y(b.to_string());
+        REQUIRE((x + y).to_string() == (a + b).to_string());
+        REQUIRE((y - x).to_string() == (b - a).to_string());
+        REQUIRE((x * y).to_string() == (a * b).to_string());
+        REQUIRE((x / y).to_string() == (a / b).to_string());
+        REQUIRE((x % y).to_string() == (a % b).to_string());
+        REQUIRE((x * 12345 - 6789).to_string() == (a * 12345 - 6789).to_string());
+        REQUIRE(gcd(x * 1000001, y * 1000001).to_string() == gcd(a * 1000001, b * 1000001).to_string());
+        REQUIRE(sqrt(x).to_string() == sqrt(a).to_string());
+        REQUIRE(powmod(y, x, radix_10000(1000000007)).to_string() == powmod(b, a, bigint(1000000007)).to_string());
+        REQUIRE((x & y).to_string() == (a & b).to_string());
+        REQUIRE(x.bit_length() == a.bit_length());
+        REQUIRE(x.mod_small(4294967291) == a.mod_small(4294967291));
+        REQUIRE(radix_10000::pow10(37).to_string() == bigint::pow10(37).to_string());
+
+        std::ostringstream radix_stream;
+        std::ostringstream bigint_stream;
+        radix_stream << std::hex << x;
+        bigint_stream << std::hex << a;
+        REQUIRE(radix_stream.str() == bigint_stream.str());
+
+#ifdef ZXSHADY_BIGINT_HAS_INT128
+        using wide_limbs = basic_bigint<std::uint64_t, 1000000000u>;
+        const wide_limbs u(a.to_string());
+        const wide_limbs v(b.to_string());
+        REQUIRE((u * v).to_string() == (a * b).to_string());
+        REQUIRE((u / v).to_string() == (a / b).to_string());
+        REQUIRE((u % v).to_string() == (a % b).to_string());
+        REQUIRE(iroot(u, 5).to_string() == iroot(a, 5).to_string());
+        REQUIRE(fac(wide_limbs(300)).to_string() == fac(bigint(300)).to_string());
+#endif
+    }
+
+    TEST_CASE("allocators", "[allocator]")
+    {
+        // results take the allocator of the left operand, temporaries never fall back to a default constructed one
+        using counted = basic_bigint<std::uint32_t, 1000000000u, counting_allocator<std::uint32_t>>;
+        std::size_t count = 0;
+        const counting_allocator<std::uint32_t> alloc(&count);
+        const bigint a = pow(bigint(3), 2000) - 7;
+        const bigint b = pow(bigint(7), 600) + 1;
+        const counted x(a.to_string(), alloc);
+        const counted y(b.to_string(), alloc);
+        REQUIRE(count != 0);
+        REQUIRE(x.get_allocator() == alloc);
+        REQUIRE(counted(x).get_allocator() == alloc);
+        REQUIRE(counted(x, counting_allocator<std::uint32_t>()).get_allocator() != alloc);
+
+        const std::size_t strays = counting_allocator<std::uint32_t>::stray_allocations;
+        const std::size_t before = count;
+        REQUIRE((x + y).to_string() == (a + b).to_string());
+        REQUIRE((y - x).to_string() == (b - a).to_string());
+        REQUIRE((x * y).to_string() == (a * b).to_string());
+        REQUIRE((x * x).to_string() == (a * a).to_string());
+        REQUIRE((x / y).to_string() == (a / b).to_string());
+        REQUIRE((x % y).to_string() == (a % b).to_string());
+        REQUIRE((x * 12345 + 6789).to_string() == (a * 12345 + 6789).to_string());
+        REQUIRE((x / 98765).to_string() == (a / 98765).to_string());
+        REQUIRE((x * y).get_allocator() == alloc);
+        REQUIRE((x / y).get_allocator() == alloc);
+        counted quotient(alloc);
+        counted remainder(alloc);
+        counted::divmod(x, y, quotient, remainder);
+        REQUIRE(quotient.to_string() == (a / b).to_string());
+        REQUIRE(remainder.to_string() == (a % b).to_string());
+        REQUIRE(count > before);
+        REQUIRE(counting_allocator<std::uint32_t>::stray_allocations == strays);
+
+        // big enough for toom-3, the ntt, burnikel-ziegler and newton division
+        const bigint c = pow(bigint(3), 12000) + 11;
+        const bigint d = pow(bigint(7), 4000) - 3;
+        const bigint e = pow(bigint(3), 40000) + 5;
+        const bigint f = pow(bigint(7), 16000) + 9;
+        const bigint g = pow(bigint(3), 160000) - 1;
+        const bigint h = pow(bigint(7), 48000) + 13;
+        const counted cx(c.to_string(), alloc);
+        const counted dx(d.to_string(), alloc);
+        const counted ex(e.to_string(), alloc);
+        const counted fx(f.to_string(), alloc);
+        const counted gx(g.to_string(), alloc);
+        const counted hx(h.to_string(), alloc);
+        REQUIRE((cx * dx).to_string() == (c * d).to_string());
+        REQUIRE((ex * fx).to_string() == (e * f).to_string());
+        REQUIRE((ex / dx).to_string() == (e / d).to_string());
+        REQUIRE((gx % hx).to_string() == (g % h).to_string());
+        REQUIRE(counted::pow10(5000, alloc).get_allocator() == alloc);
+        REQUIRE(iroot(cx, 3).to_string() == iroot(c, 3).to_string());
+        REQUIRE(iroot(counted(1, alloc), 3).get_allocator() == alloc);
+        REQUIRE(powmod(x, counted(0, alloc), y).get_allocator() == alloc);
+        REQUIRE(powmod(x, y, dx).to_string() == powmod(a, b, d).to_string());
+        REQUIRE((x & y).get_allocator() == alloc);
+        REQUIRE(counting_allocator<std::uint32_t>::stray_allocations == strays);
+
+#ifdef __cpp_lib_memory_resource
+        // a whole computation out of one arena, released at the end of the scope
+        std::vector<unsigned char> buffer(1 << 20);
+        std::pmr::monotonic_buffer_resource arena(buffer.data(), buffer.size(), std::pmr::null_memory_resource());
+        const zxshady::pmr::bigint u(a.to_string(), &arena);
+        const zxshady::pmr::bigint v(b.to_string(), &arena);
+        zxshady::pmr::bigint total(&arena);
+        for (int i = 1; i <= 20; ++i)
+            total += u * v / (v + i);
+        REQUIRE(total.get_allocator().resource() == &arena);
+        REQUIRE(total.to_string() == [&] {
+            bigint expected;
+            for (int i = 1; i <= 20; ++i)
+                expected += a * b / (b + i);
+            return expected.to_string();
+        }());
+#endif
+    }
 }
\ No newline at end of file
@@ -0,0 +1,231 @@
+#ifdef NDEBUG
+#undef NDEBUG
+#endif // NDEBUG
+
+
+#include "binary_bigint.hpp"
+#include <climits>
+#include <cassert>
+#include <iostream>
+#include <sstream>
+
+
+
+#ifndef NDEBUG
+#define TEST_CASE(a,b) std::puts("reached " #a " " # b" !");
+#define REQUIRE(...) do{try{assert(__VA_ARGS__);}catch(...){assert(false);}}while(false)
+#define CHECK(x) if(!(x)) { std::printf("line %d check failed...",__LINE__);}
+#else
+#define TEST_CASE(a,b) std::puts("reached " #a " " # b" !");
+#define REQUIRE(...) static_cast<void>(__VA_ARGS__)
+#define CHECK(x) 
+
+#endif
+void binary_bigint_test()
+{
+    using namespace zxshady;
+
+    TEST_CASE("Base Initializing", "[binary][constructors]")
+    {
+        REQUIRE(binary_bigint().to_string() == "0");
+        REQUIRE(binary_bigint(0).to_string() == "0");
+        REQUIRE(binary_bigint(-1).to_string() == "-1");
+        REQUIRE(binary_bigint((std::numeric_limits<long long>::min)()).to<long long>() == (std::numeric_limits<long long>::min)());
+        REQUIRE(binary_bigint((std::numeric_limits<unsigned long long>::max)()).to<unsigned long long>() == (std::numeric_limits<unsigned long long>::max)());
+        REQUIRE(binary_bigint("123456789012345678901234567890").to_string() == "123456789012345678901234567890");
+        REQUIRE(binary_bigint("-000123").to_string() == "-123");
+        REQUIRE(binary_bigint("-0") == 0);
+        REQUIRE(binary_bigint("0xDeAdBeEf") == 3735928559u);
+        REQUIRE(binary_bigint("0B1101") == 13);
+        REQUIRE(binary_bigint("0o70") == 56);
+        REQUIRE(binary_bigint("1'000'000") == 1000000);
+
+        const std::string str = "ff'ff";
+        REQUIRE(binary_bigint(str.begin(), str.end(), bigint::base::hex) == 65535);
+
+        bool threw = false;
+        try {
+            binary_bigint bad("12a4");
+        }
+        catch (const bigint_format_error&) {
+            threw = true;
+        }
+        REQUIRE(threw);
+
+        threw = false;
+        try {
+            static_cast<void>(binary_bigint(-1).to<unsigned int>());
+        }
+        catch (const std::range_error&) {
+            threw = true;
+        }
+        REQUIRE(threw);
+        REQUIRE(!binary_bigint(1).mul_2exp(63).non_throwing_to<long long>());
+        REQUIRE(-binary_bigint(1).mul_2exp(63) == (std::numeric_limits<long long>::min)());
+    }
+
+    TEST_CASE("conversion from and to bigint", "[binary][bigint]")
+    {
+        // long enough for both the recursive decimal conversions and the direct ones
+        for (unsigned long long k : { 0ull, 1ull, 20ull, 100ull, 1000ull, 5000ull }) {
+            const bigint x = pow(bigint(7), k) + 3;
+            const binary_bigint y(x);
+            REQUIRE(y.to_bigint() == x);
+            REQUIRE((-y).to_bigint() == -x);
+            REQUIRE(y.to_string() == x.to_string());
+            REQUIRE(binary_bigint(x.to_string()) == y);
+            REQUIRE(y.digit_count() == x.digit_count());
+            REQUIRE(y.bit_length() == x.bit_length());
+        }
+        REQUIRE(binary_bigint(bigint()) == 0);
+        REQUIRE(binary_bigint::pow10(40).to_string() == "1" + std::string(40, '0'));
+        REQUIRE(binary_bigint::pow10(40).digit_count() == 41);
+        REQUIRE((binary_bigint::pow10(40) - 1).digit_count() == 40);
+    }
+
+    TEST_CASE("arithmetic matches bigint", "[binary][functions][operators]")
+    {
+        const bigint values[] = {
+            bigint(0), bigint(1), bigint(-1),
+            bigint((std::numeric_limits<unsigned long long>::max)()),
+            pow(bigint(2), 64), -pow(bigint(2), 128) + 1,
+            pow(bigint(7), 300) + 3, -pow(bigint(3), 1500),
+            pow(bigint(11), 3000) - 1
+        };
+
+        for (const auto& a : values) {
+            for (const auto& b : values) {
+                const binary_bigint x(a), y(b);
+                REQUIRE((x + y).to_bigint() == a + b);
+                REQUIRE((x - y).to_bigint() == a - b);
+                REQUIRE((x * y).to_bigint() == a * b);
+                REQUIRE((x < y) == (a < b));
+                REQUIRE((x == y) == (a == b));
+                if (b) {
+                    REQUIRE((x / y).to_bigint() == a / b);
+                    REQUIRE((x % y).to_bigint() == a % b);
+                }
+            }
+        }
+
+        binary_bigint x = pow(binary_bigint(3), 200);
+        x += x;
+        REQUIRE(x == 2 * pow(binary_bigint(3), 200));
+        x -= x;
+        REQUIRE(x == 0);
+        REQUIRE(!x.is_negative());
+
+        x = -5;
+        REQUIRE(x + 7 == 2);
+        REQUIRE(x - 1999999999 == -2000000004);
+        REQUIRE(x * -3 == 15);
+        REQUIRE(x / 2 == -2);
+        REQUIRE(x % 2 == -1);
+        REQUIRE(-7 < x);
+        REQUIRE(x < 0u);
+        REQUIRE(++x == -4);
+        REQUIRE(--x == -5);
+
+        const binary_bigint big = pow(binary_bigint(10), 60) + 7;
+        REQUIRE(big % 1000 == 7);
+        REQUIRE(big.mod_small(1000000007) == (pow(bigint(10), 60) + 7).mod_small(1000000007));
+        REQUIRE(big / pow(binary_bigint(10), 59) == 10);
+
+        const auto qr = binary_bigint::divmod(-big, binary_bigint(1000));
+        REQUIRE(qr.first == -(pow(binary_bigint(10), 57)));
+        REQUIRE(qr.second == -7);
+
+        bool threw = false;
+        try {
+            x /= 0;
+        }
+        catch (const std::invalid_argument&) {
+            threw = true;
+        }
+        REQUIRE(threw);
+    }
+
+    TEST_CASE("pow(), sqrt(), gcd() and powmod()", "[binary][functions][math]")
+    {
+        REQUIRE(pow(binary_bigint(2), 100).to_bigint() == pow(bigint(2), 100));
+        REQUIRE(pow(binary_bigint(-3), 301).to_bigint() == pow(bigint(-3), 301));
+        REQUIRE(pow(binary_bigint(12345), 0) == 1);
+        REQUIRE(log2(binary_bigint(1).mul_2exp(777)) == 777);
+
+        const binary_bigint square = pow(binary_bigint(7), 400);
+        REQUIRE(sqrt(square) == pow(binary_bigint(7), 200));
+        REQUIRE(sqrt(square - 1) == pow(binary_bigint(7), 200) - 1);
+        REQUIRE(sqrt(binary_bigint(0)) == 0);
+
+        REQUIRE(gcd(binary_bigint(-12), binary_bigint(18)) == 6);
+        REQUIRE(gcd(pow(binary_bigint(6), 100), pow(binary_bigint(10), 80)) == pow(binary_bigint(2), 80));
+        REQUIRE(lcm(binary_bigint(4), binary_bigint(-6)) == 12);
+
+        const bigint m = pow(bigint(7), 250) + 2;
+        const bigint base = pow(bigint(3), 333) - 5;
+        const bigint exponent = pow(bigint(5), 120);
+        REQUIRE(powmod(binary_bigint(base), binary_bigint(exponent), binary_bigint(m)).to_bigint() == powmod(base, exponent, m));
+        REQUIRE(powmod(binary_bigint(-base), binary_bigint(exponent), binary_bigint(m)).to_bigint() == powmod(-base, exponent, m));
+        REQUIRE(powmod(binary_bigint(base), binary_bigint(exponent), binary_bigint(m + 1)).to_bigint() == powmod(base, exponent, m + 1));
+        REQUIRE(powmod(binary_bigint(base), binary_bigint(0), binary_bigint(m)) == 1);
+        REQUIRE(powmod(binary_bigint(base), binary_bigint(exponent), binary_bigint(1)) == 0);
+    }
+
+    TEST_CASE("bitwise operators and shifts", "[binary][functions][operators][bitwise]")
+    {
+        const binary_bigint power = binary_bigint(1) << 5000;
+        REQUIRE((binary_bigint(12) & 10) == 8);
+        REQUIRE((binary_bigint(12) | 3) == 15);
+        REQUIRE((binary_bigint(12) ^ 10) == 6);
+        REQUIRE((binary_bigint(-12) & 10) == 0);
+        REQUIRE((binary_bigint(-12) | 3) == -9);
+        REQUIRE((binary_bigint(-12) ^ -10) == 2);
+        REQUIRE(((-power - 1) & (power + 7)) == 7);
+        REQUIRE(~binary_bigint(0) == -1);
+        REQUIRE(((power - 1) & power) == 0);
+        REQUIRE(((power - 1) ^ power) == (power << 1) - 1);
+
+        REQUIRE((power >> 4990) == 1024);
+        REQUIRE((binary_bigint(-7) >> 1) == -4);
+        REQUIRE((-power >> 5001) == -1);
+        REQUIRE(((-power - 1) >> 5000) == -2);
+        REQUIRE(binary_bigint(-7).div_2exp(1) == -3);
+
+        REQUIRE(power.test_bit(5000));
+        REQUIRE(!power.test_bit(4999));
+        REQUIRE((-power).test_bit(100000));
+        REQUIRE(!(-power).test_bit(4999));
+        REQUIRE(power.is_pow_of_2());
+        REQUIRE(!(power + 1).is_pow_of_2());
+        REQUIRE(!(-power).is_pow_of_2());
+        REQUIRE(!binary_bigint(-1).is_pow_of_2());
+        REQUIRE(!binary_bigint(-8).is_pow_of_2());
+        REQUIRE(!(-(binary_bigint(1) << 64)).is_pow_of_2());
+        REQUIRE(binary_bigint(0).is_pow_of_2());
+        REQUIRE(binary_bigint(1).is_pow_of_2());
+
+        binary_bigint x = 5;
+        x.set_bit(1);
+        REQUIRE(x == 7);
+        x.set_bit(0, false).set_bit(6000);
+        REQUIRE(x == (binary_bigint(1) << 6000) + 6);
+
+        REQUIRE((power - 1).popcount() == 5000);
+        REQUIRE(binary_bigint(-1).popcount() == (std::numeric_limits<std::size_t>::max)());
+        REQUIRE((power * 3).count_trailing_zeros() == 5000);
+        REQUIRE(binary_bigint(-40).count_trailing_zeros() == 3);
+    }
+
+    TEST_CASE("stream operators", "[binary][io]")
+    {
+        std::ostringstream out;
+        out << binary_bigint(-255) << ' ' << std::hex << binary_bigint(-255) << ' ' << std::showbase << std::uppercase << binary_bigint(255)
+            << ' ' << std::oct << binary_bigint(8) << ' ' << std::dec << std::showpos << binary_bigint(3);
+        REQUIRE(out.str() == "-255 -ff 0XFF 0O10 +3");
+
+        std::istringstream in("-123456789012345678901234567890");
+        binary_bigint x;
+        in >> x;
+        REQUIRE(x == binary_bigint("-123456789012345678901234567890"));
+    }
+}
\ No newline at end of file
@@ -50,5 +50,20 @@ ZXSHADY_NODISCARD inline type1 operator*(type1 a,type2 b) { return a *= b;}\
 ZXSHADY_NODISCARD inline type1 operator/(type1 a,type2 b) { return a /= b;}\
 ZXSHADY_NODISCARD inline type1 operator%(type1 a,type2 b) { return a %= b;}
 
+// the same as the two above for hidden friends defined inside a class
+#define ZXSHADY_DEFINE_FRIEND_COMPARISONS(type1,type2) \
+ZXSHADY_NODISCARD friend bool operator>(type1 a,type2 b) noexcept { return b < a;} \
+ZXSHADY_NODISCARD friend bool operator<=(type1 a,type2 b) noexcept { return !(a > b);} \
+ZXSHADY_NODISCARD friend bool operator>=(type1 a,type2 b) noexcept { return !(a < b);} \
+ZXSHADY_NODISCARD friend bool operator!=(type1 a,type2 b) noexcept { return !(a == b);}
+
+
+#define ZXSHADY_DEFINE_FRIEND_ARITHMETIC(type1,type2) \
+ZXSHADY_NODISCARD friend type1 operator+(type1 a,type2 b) { return a += b;}\
+ZXSHADY_NODISCARD friend type1 operator-(type1 a,type2 b) { return a -= b;}\
+ZXSHADY_NODISCARD friend type1 operator*(type1 a,type2 b) { return a *= b;}\
+ZXSHADY_NODISCARD friend type1 operator/(type1 a,type2 b) { return a /= b;}\
+ZXSHADY_NODISCARD friend type1 operator%(type1 a,type2 b) { return a %= b;}
+
 
 #endif // !defined(ZXSHADY_MACROS_HPP)
\ No newline at end of file
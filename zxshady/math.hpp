@@ -78,7 +78,7 @@ template<typename T>
         return 1ULL << exponent;
     }
 
-    ZXSHADY_CONSTEXPR14 unsigned long long pow10(unsigned long long exponent) noexcept
+    inline ZXSHADY_CONSTEXPR14 unsigned long long pow10(unsigned long long exponent) noexcept
     {
         constexpr unsigned long long mPow10Table[] = {
             1,
@@ -97,7 +97,10 @@ template<typename T>
             10000000000000,
             100000000000000,
             1000000000000000,
-            10000000000000000
+            10000000000000000,
+            100000000000000000,
+            1000000000000000000,
+            10000000000000000000ULL
         };
         return mPow10Table[exponent];
     }